@@ -0,0 +1,502 @@
+/**
+ * @file ConcurrentSkipList.cpp
+ * @brief Lazy-locking concurrent skip list (ordered map) with wait-free
+ *        lookups, consistent range scans and epoch-based reclamation.
+ * @date 2026-10-17
+ *
+ * BST and std::map need an external lock to be shared between threads, and
+ * then every writer serializes on it. A skip list keeps its keys in a sorted
+ * linked list (level 0) with sparser express lists above it, so a change only
+ * touches a node's immediate predecessors.
+ *
+ * ConcurrentSkipList follows the lazy skip list of Herlihy, Lev, Luchangco and
+ * Shavit (2006):
+ * - find() and scans take no locks. They walk the levels top-down and trust a
+ *   node once it is fullyLinked and not marked.
+ * - insert() finds the predecessors, locks them bottom-up, re-checks that they
+ *   are unmarked and still point at the same successors, links the new node
+ *   from level 0 upwards and finally sets fullyLinked (the linearization
+ *   point). Validation failures retry from the search.
+ * - erase() first marks the victim under its own lock (the linearization
+ *   point), then locks and validates the predecessors and unlinks it top-down.
+ * - An unlinked node keeps its next pointers, so a reader standing on it still
+ *   reaches larger keys. Nodes are freed through EpochDomain only after every
+ *   thread that might hold a pointer has left its critical section.
+ * Writers on different parts of the key space never touch the same lock.
+ *
+ * scan(lo, hi, fn) visits keys in ascending order without duplicates. Each key
+ * present for the whole scan is reported, and no key absent for the whole scan
+ * is (the same weak consistency as Java's ConcurrentSkipListMap iterators).
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+// Process-wide epoch-based reclamation; each thread keeps its own limbo list.
+class EpochDomain {
+public:
+    static constexpr std::uint64_t INACTIVE = ~0ULL;
+    static constexpr std::size_t MAX_THREADS = 256;
+    static constexpr std::size_t COLLECT_EVERY = 64;
+
+private:
+    struct Retired {
+        std::uint64_t epoch;
+        void* p;
+        void (*free)(void*);
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> epoch{INACTIVE};
+        std::atomic<bool> claimed{false};
+    };
+
+    struct ThreadRecord {
+        EpochDomain& d;
+        Slot* slot = nullptr;
+        unsigned depth = 0;
+        std::vector<Retired> limbo;
+        explicit ThreadRecord(EpochDomain& domain) : d(domain) {
+            for (Slot& s : d.slots) {
+                bool expected = false;
+                if (!s.claimed.load(std::memory_order_relaxed) && s.claimed.compare_exchange_strong(expected, true)) {
+                    slot = &s;
+                    return;
+                }
+            }
+            throw std::runtime_error("EpochDomain: more than MAX_THREADS threads");
+        }
+        // Leftovers go to the domain, which frees them once they are safe.
+        ~ThreadRecord() {
+            std::lock_guard<std::mutex> lock(d.orphanMutex);
+            d.orphans.insert(d.orphans.end(), limbo.begin(), limbo.end());
+            slot->claimed.store(false, std::memory_order_release);
+        }
+    };
+
+    alignas(64) std::atomic<std::uint64_t> global{1};
+    Slot slots[MAX_THREADS];
+    std::mutex orphanMutex;
+    std::vector<Retired> orphans;
+
+    ThreadRecord& record() {
+        thread_local ThreadRecord r(*this);
+        return r;
+    }
+
+    // Frees the entries retired at least two epochs ago; epochs are nondecreasing.
+    static void reclaim(std::vector<Retired>& list, std::uint64_t now) {
+        std::size_t i = 0;
+        while (i < list.size() && list[i].epoch + 2 <= now) { list[i].free(list[i].p); ++i; }
+        list.erase(list.begin(), list.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    bool tryAdvance() {
+        std::uint64_t e = global.load();
+        for (const Slot& s : slots) {
+            std::uint64_t seen = s.epoch.load();
+            if (seen != INACTIVE && seen != e) return false;
+        }
+        return global.compare_exchange_strong(e, e + 1);
+    }
+
+public:
+    static EpochDomain& instance() {
+        static EpochDomain d;
+        return d;
+    }
+    // Runs at exit, after every thread has finished.
+    ~EpochDomain() { for (Retired& r : orphans) r.free(r.p); }
+
+    // Pins the current epoch for the guard's lifetime; guards may nest.
+    class Guard {
+        ThreadRecord& r;
+    public:
+        explicit Guard(EpochDomain& d) : r(d.record()) {
+            if (r.depth++ == 0) {
+                r.slot->epoch.store(d.global.load(), std::memory_order_seq_cst);
+                // Order the pin before the reader's acquire loads of next pointers.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+        ~Guard() {
+            if (--r.depth == 0) r.slot->epoch.store(INACTIVE, std::memory_order_release);
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    // Frees p with fn once no thread can still be reading it.
+    void retire(void* p, void (*fn)(void*)) {
+        ThreadRecord& r = record();
+        r.limbo.push_back({global.load(), p, fn});
+        if (r.limbo.size() % COLLECT_EVERY != 0) return;
+        tryAdvance();
+        std::uint64_t now = global.load();
+        reclaim(r.limbo, now);
+        std::unique_lock<std::mutex> lock(orphanMutex, std::try_to_lock);
+        if (lock.owns_lock()) reclaim(orphans, now);
+    }
+};
+
+template<class K, class V>
+class ConcurrentSkipList {
+public:
+    static constexpr int MAX_LEVEL = 16;   // p = 1/4 per level: ~4^16 keys
+
+private:
+    struct alignas(alignof(std::atomic<void*>)) Node {
+        K key;
+        V value;
+        int topLevel;   // index of the highest level this node is linked on
+        std::atomic<bool> locked{false};
+        std::atomic<bool> marked{false};
+        std::atomic<bool> fullyLinked{false};
+
+        Node(const K& k, const V& v, int top) : key(k), value(v), topLevel(top) {}
+        // The level pointers are stored right after the node.
+        std::atomic<Node*>* next() { return reinterpret_cast<std::atomic<Node*>*>(this + 1); }
+
+        void lock() {
+            for (;;) {
+                if (!locked.exchange(true, std::memory_order_acquire)) return;
+                while (locked.load(std::memory_order_relaxed)) std::this_thread::yield();
+            }
+        }
+        void unlock() { locked.store(false, std::memory_order_release); }
+    };
+
+    Node* head;
+    std::atomic<std::size_t> count{0};
+    EpochDomain& domain = EpochDomain::instance();
+
+    static Node* makeNode(const K& k, const V& v, int top) {
+        void* mem = ::operator new(sizeof(Node) + static_cast<std::size_t>(top + 1) * sizeof(std::atomic<Node*>));
+        Node* n = new (mem) Node(k, v, top);
+        for (int i = 0; i <= top; ++i) new (&n->next()[i]) std::atomic<Node*>(nullptr);
+        return n;
+    }
+    static void freeNode(void* p) {
+        Node* n = static_cast<Node*>(p);
+        n->~Node();
+        ::operator delete(p);
+    }
+
+    static int randomLevel() {
+        thread_local std::uint64_t s = 0x9e3779b97f4a7c15ULL ^ reinterpret_cast<std::uintptr_t>(&s);
+        s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+        int level = 0;
+        for (std::uint64_t bits = s; (bits & 3) == 0 && level < MAX_LEVEL - 1; bits >>= 2) ++level;
+        return level;
+    }
+
+    // Fills preds/succs on every level; returns the highest level holding key, or -1.
+    int findNode(const K& key, Node** preds, Node** succs) const {
+        int found = -1;
+        Node* pred = head;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            Node* curr = pred->next()[level].load(std::memory_order_acquire);
+            while (curr && curr->key < key) {
+                pred = curr;
+                curr = pred->next()[level].load(std::memory_order_acquire);
+            }
+            if (found == -1 && curr && !(key < curr->key)) found = level;
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return found;
+    }
+
+    // Locks preds[0..top] (each distinct node once); true if all still match.
+    template<class Check>
+    static bool lockPreds(Node** preds, int top, int& highestLocked, Check&& valid) {
+        Node* prev = nullptr;
+        for (int level = 0; level <= top; ++level) {
+            if (preds[level] != prev) {
+                preds[level]->lock();
+                highestLocked = level;
+                prev = preds[level];
+            }
+            if (!valid(level)) return false;
+        }
+        return true;
+    }
+    static void unlockPreds(Node** preds, int highestLocked) {
+        Node* prev = nullptr;
+        for (int level = 0; level <= highestLocked; ++level)
+            if (preds[level] != prev) { preds[level]->unlock(); prev = preds[level]; }
+    }
+
+public:
+    ConcurrentSkipList() : head(makeNode(K(), V(), MAX_LEVEL - 1)) {}
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+    // No other thread may still be using the list.
+    ~ConcurrentSkipList() {
+        for (Node* n = head; n;) {
+            Node* next = n->next()[0].load(std::memory_order_relaxed);
+            freeNode(n);
+            n = next;
+        }
+    }
+
+    std::size_t size() const { return count.load(std::memory_order_relaxed); }
+
+    // Returns false (leaving the old value) if key is present.
+    bool insert(const K& key, const V& value) {
+        EpochDomain::Guard guard(domain);
+        int top = randomLevel();
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        for (;;) {
+            int found = findNode(key, preds, succs);
+            if (found != -1) {
+                Node* existing = succs[found];
+                if (!existing->marked.load(std::memory_order_acquire)) {
+                    while (!existing->fullyLinked.load(std::memory_order_acquire)) std::this_thread::yield();
+                    return false;
+                }
+                continue;   // being erased; wait for it to disappear
+            }
+            int highestLocked = -1;
+            bool ok = lockPreds(preds, top, highestLocked, [&](int level) {
+                Node* succ = succs[level];
+                return !preds[level]->marked.load(std::memory_order_relaxed) &&
+                       (!succ || !succ->marked.load(std::memory_order_relaxed)) &&
+                       preds[level]->next()[level].load(std::memory_order_relaxed) == succ;
+            });
+            if (!ok) { unlockPreds(preds, highestLocked); continue; }
+            Node* node = makeNode(key, value, top);
+            for (int level = 0; level <= top; ++level) node->next()[level].store(succs[level], std::memory_order_relaxed);
+            for (int level = 0; level <= top; ++level) preds[level]->next()[level].store(node, std::memory_order_release);
+            node->fullyLinked.store(true, std::memory_order_release);
+            unlockPreds(preds, highestLocked);
+            count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Returns false if key is absent.
+    bool erase(const K& key) {
+        EpochDomain::Guard guard(domain);
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        Node* victim = nullptr;
+        bool isMarked = false;
+        int top = -1;
+        for (;;) {
+            int found = findNode(key, preds, succs);
+            if (!isMarked) {
+                if (found == -1) return false;
+                victim = succs[found];
+                // Only a fully linked node found at its own top level can be erased now.
+                if (!victim->fullyLinked.load(std::memory_order_acquire) || victim->topLevel != found ||
+                    victim->marked.load(std::memory_order_acquire))
+                    return false;
+                top = victim->topLevel;
+                victim->lock();
+                if (victim->marked.load(std::memory_order_relaxed)) { victim->unlock(); return false; }
+                victim->marked.store(true, std::memory_order_release);
+                isMarked = true;
+            }
+            int highestLocked = -1;
+            bool ok = lockPreds(preds, top, highestLocked, [&](int level) {
+                return !preds[level]->marked.load(std::memory_order_relaxed) &&
+                       preds[level]->next()[level].load(std::memory_order_relaxed) == victim;
+            });
+            if (!ok) { unlockPreds(preds, highestLocked); continue; }
+            for (int level = top; level >= 0; --level)
+                preds[level]->next()[level].store(victim->next()[level].load(std::memory_order_relaxed), std::memory_order_release);
+            victim->unlock();
+            unlockPreds(preds, highestLocked);
+            count.fetch_sub(1, std::memory_order_relaxed);
+            // Pairs with the fence in Guard: the unlink is ordered before retire reads the epoch.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            domain.retire(victim, &freeNode);
+            return true;
+        }
+    }
+
+    std::optional<V> find(const K& key) const {
+        EpochDomain::Guard guard(domain);
+        // Same descent as findNode, but stops at the first level that holds key.
+        Node* pred = head;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            Node* curr = pred->next()[level].load(std::memory_order_acquire);
+            while (curr && curr->key < key) {
+                pred = curr;
+                curr = pred->next()[level].load(std::memory_order_acquire);
+            }
+            if (curr && !(key < curr->key)) {
+                if (!curr->fullyLinked.load(std::memory_order_acquire) || curr->marked.load(std::memory_order_acquire))
+                    return std::nullopt;
+                return curr->value;
+            }
+        }
+        return std::nullopt;
+    }
+    bool contains(const K& key) const { return find(key).has_value(); }
+
+    // Calls fn(key, value) for keys in [lo, hi) in ascending order; stops early
+    // if fn returns false.
+    template<class F>
+    void scan(const K& lo, const K& hi, F&& fn) const {
+        EpochDomain::Guard guard(domain);
+        Node* pred = head;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level)
+            for (Node* curr = pred->next()[level].load(std::memory_order_acquire); curr && curr->key < lo;
+                 curr = pred->next()[level].load(std::memory_order_acquire))
+                pred = curr;
+        for (Node* n = pred->next()[0].load(std::memory_order_acquire); n && n->key < hi;
+             n = n->next()[0].load(std::memory_order_acquire)) {
+            if (!n->fullyLinked.load(std::memory_order_acquire) || n->marked.load(std::memory_order_acquire)) continue;
+            if (!(n->key < lo) && !fn(n->key, n->value)) return;
+        }
+    }
+};
+
+// Baseline: std::map behind one lock.
+template<class Mutex>
+class LockedMap {
+    std::map<std::int64_t, std::int64_t> m;
+    mutable Mutex mtx;
+    // Shared lock when the mutex supports it.
+    auto readLock() const {
+        if constexpr (std::is_same_v<Mutex, std::shared_mutex>) return std::shared_lock<Mutex>(mtx);
+        else return std::unique_lock<Mutex>(mtx);
+    }
+public:
+    bool insert(std::int64_t k, std::int64_t v) { std::unique_lock<Mutex> l(mtx); return m.emplace(k, v).second; }
+    bool erase(std::int64_t k) { std::unique_lock<Mutex> l(mtx); return m.erase(k) != 0; }
+    bool contains(std::int64_t k) const { auto l = readLock(); return m.count(k) != 0; }
+    template<class F>
+    void scan(std::int64_t lo, std::int64_t hi, F&& fn) const {
+        auto l = readLock();
+        for (auto it = m.lower_bound(lo); it != m.end() && it->first < hi; ++it)
+            if (!fn(it->first, it->second)) return;
+    }
+};
+
+// threads run a mix of finds, inserts, erases and short scans over keys in
+// [0, keyRange) for durationMs; returns million operations per second.
+template<class M>
+double run(M& map, unsigned threads, std::int64_t keyRange, int findPct, int scanPct, int durationMs) {
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> ops{0}, sink{0};
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t)
+        pool.emplace_back([&, t] {
+            std::uint64_t s = 0x2545F4914F6CDD1DULL * (t + 1), local = 0, seen = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int b = 0; b < 64; ++b) {
+                    s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+                    std::int64_t k = static_cast<std::int64_t>(s % static_cast<std::uint64_t>(keyRange));
+                    int op = static_cast<int>((s >> 40) % 100);
+                    if (op < scanPct) map.scan(k, k + 100, [&](std::int64_t key, std::int64_t) { seen += static_cast<std::uint64_t>(key); return true; });
+                    else if (op < scanPct + findPct) seen += map.contains(k);
+                    else if (op % 2) map.insert(k, k);
+                    else map.erase(k);
+                }
+                local += 64;
+            }
+            ops += local;
+            sink += seen;
+        });
+    auto t0 = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+    stop = true;
+    for (auto& th : pool) th.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return static_cast<double>(ops.load()) / sec / 1e6;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Concurrent skip list ===\n";
+    ConcurrentSkipList<int, std::string> book;
+    for (int price : {101, 99, 105, 100, 103}) book.insert(price, "level " + std::to_string(price));
+    book.erase(105);
+    std::cout << "scan [100, 104):";
+    book.scan(100, 104, [](int k, const std::string& v) { std::cout << ' ' << k << '=' << v; return true; });
+    std::cout << "\nfind(99) = " << book.find(99).value_or("none") << ", size " << book.size() << '\n';
+
+    // Usage: ./ConcurrentSkipList [keyRange] [maxThreads] [ms]
+    std::int64_t keyRange = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+    int ms = argc > 3 ? std::atoi(argv[3]) : 500;
+
+    // Consistency under churn: writers toggle odd keys while scanners check that
+    // every even key is seen exactly once and in order.
+    {
+        ConcurrentSkipList<std::int64_t, std::int64_t> list;
+        const std::int64_t span = 20000;
+        for (std::int64_t k = 0; k < span; k += 2) list.insert(k, k);
+        std::atomic<bool> stop{false};
+        std::atomic<std::uint64_t> errors{0}, scans{0};
+        std::vector<std::thread> pool;
+        unsigned writers = std::max(2u, maxThreads);
+        for (unsigned t = 0; t < writers; ++t)
+            pool.emplace_back([&, t] {
+                std::uint64_t s = t * 7919 + 1;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+                    std::int64_t k = static_cast<std::int64_t>(s % span) | 1;
+                    if (s & 0x100) list.insert(k, k); else list.erase(k);
+                }
+            });
+        pool.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::int64_t last = -1, nextEven = 0;
+                list.scan(0, span, [&](std::int64_t k, std::int64_t v) {
+                    if (k <= last || v != k || (k % 2 == 0 && k != nextEven)) ++errors;
+                    if (k % 2 == 0) nextEven = k + 2;
+                    last = k;
+                    return true;
+                });
+                if (nextEven != span) ++errors;
+                ++scans;
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        stop = true;
+        for (auto& th : pool) th.join();
+        std::size_t walked = 0;
+        list.scan(0, span, [&](std::int64_t, std::int64_t) { ++walked; return true; });
+        if (walked != list.size()) ++errors;
+        std::cout << "\nchurn check: " << writers << " writers, " << scans << " full scans, " << errors << " errors\n";
+        if (errors) return 1;
+    }
+
+    std::cout << "\n" << keyRange << " keys, M ops/s (skip list / map+mutex / map+shared_mutex)\n"
+              << std::fixed << std::setprecision(2)
+              << "  threads   90% find, 1% scan            50% find, 1% scan\n";
+    for (unsigned t = 1; t <= maxThreads; t *= 2) {
+        std::cout << std::setw(9) << t << "   ";
+        for (int findPct : {90, 50}) {
+            ConcurrentSkipList<std::int64_t, std::int64_t> list;
+            LockedMap<std::mutex> locked;
+            LockedMap<std::shared_mutex> shared;
+            for (std::int64_t k = 0; k < keyRange; k += 2) { list.insert(k, k); locked.insert(k, k); shared.insert(k, k); }
+            std::cout << std::setw(6) << run(list, t, keyRange, findPct - 1, 1, ms) << " / " << std::setw(5)
+                      << run(locked, t, keyRange, findPct - 1, 1, ms) << " / " << std::setw(5)
+                      << run(shared, t, keyRange, findPct - 1, 1, ms) << "      ";
+        }
+        std::cout << '\n';
+    }
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 ConcurrentSkipList.cpp -o ConcurrentSkipList */
@@ -0,0 +1,283 @@
+/**
+ * @file MpmcQueue.cpp
+ * @brief Bounded lock-free multi-producer/multi-consumer queue (Vyukov) with
+ *        spin-yield-futex blocking wrappers.
+ * @date 2026-10-17
+ *
+ * The producer/consumer pattern in
+ * 07_Multithreading/03_ConditionVariables/ConditionVariableExample.cpp puts a
+ * std::queue behind one mutex and a condition_variable: every push and pop
+ * serializes on the lock, and every notify may cost a system call.
+ *
+ * MpmcQueue<T> is a power-of-two ring of cells, each with its own sequence
+ * number (Dmitry Vyukov's bounded MPMC queue):
+ * - Cell i starts with seq = i. A producer at ticket pos may write the cell
+ *   when seq == pos; it claims the ticket with a CAS on enqueuePos, writes the
+ *   item and releases seq = pos + 1. A consumer at ticket pos may read the
+ *   cell when seq == pos + 1; after reading it releases seq = pos + capacity,
+ *   which is the ticket of the next producer lap.
+ * - seq < expected means the cell is still one lap behind (full for a
+ *   producer, empty for a consumer). seq > expected means another thread took
+ *   the ticket first, so we reload the position and retry.
+ * - Tickets only grow and each cell's seq encodes the lap it belongs to, so a
+ *   stale thread can never mistake an old lap for a new one: there is no ABA
+ *   and no lock.
+ *
+ * try_push/try_pop never block. push/pop wait in three stages: spin with a
+ *   CPU pause, then yield, then sleep on a futex. Sleepers register in a
+ *   waiter count first, so the other side pays for a wake-up syscall only when
+ *   someone is actually asleep.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+constexpr std::size_t CACHE_LINE = 64;
+
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Sleeps while *word == expected (Linux futex; a short sleep elsewhere).
+static void futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    if (word.load() == expected) std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+}
+
+static void futexWake(std::atomic<std::uint32_t>& word, int count) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+    (void)word; (void)count;
+#endif
+}
+
+template<class T>
+class MpmcQueue {
+public:
+    static constexpr int SPIN_LIMIT = 64;
+    static constexpr int YIELD_LIMIT = 16;
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        T data;
+    };
+
+    // One side's wake-up state: a counter to sleep on and the number of sleepers.
+    struct alignas(CACHE_LINE) Waiters {
+        std::atomic<std::uint32_t> epoch{0};
+        std::atomic<std::uint32_t> sleeping{0};
+
+        void wakeOne() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);   // publish before checking for sleepers
+            if (sleeping.load(std::memory_order_relaxed) == 0) return;
+            epoch.fetch_add(1, std::memory_order_seq_cst);
+            futexWake(epoch, 1);
+        }
+        // Spins, yields, then sleeps until attempt() succeeds.
+        template<class Attempt>
+        void waitUntil(Attempt&& attempt) {
+            for (int i = 0; i < SPIN_LIMIT; ++i) { if (attempt()) return; cpuRelax(); }
+            for (int i = 0; i < YIELD_LIMIT; ++i) { if (attempt()) return; std::this_thread::yield(); }
+            for (;;) {
+                std::uint32_t key = epoch.load(std::memory_order_seq_cst);
+                sleeping.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);   // pairs with the fence in wakeOne
+                bool done = attempt();
+                if (!done) futexWait(epoch, key);
+                sleeping.fetch_sub(1, std::memory_order_relaxed);
+                if (done || attempt()) return;
+            }
+        }
+    };
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueuePos{0};
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeuePos{0};
+    alignas(CACHE_LINE) std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    Waiters consumers;   // sleep while empty
+    Waiters producers;   // sleep while full
+
+public:
+    explicit MpmcQueue(std::size_t capacity) {
+        if (capacity < 2 || capacity > (SIZE_MAX >> 2)) throw std::invalid_argument("MpmcQueue: bad capacity");
+        std::size_t c = 2;
+        while (c < capacity) c <<= 1;
+        mask = c - 1;
+        cells.reset(new Cell[c]);
+        for (std::size_t i = 0; i < c; ++i) cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    // Returns false if the queue is full; v is left untouched then.
+    bool try_push(T&& v) {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            std::size_t seq = cell->seq.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(v);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        consumers.wakeOne();
+        return true;
+    }
+
+    // Returns false if the queue is empty.
+    bool try_pop(T& out) {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            std::size_t seq = cell->seq.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->data);
+        cell->seq.store(pos + mask + 1, std::memory_order_release);
+        producers.wakeOne();
+        return true;
+    }
+
+    bool try_push(const T& v) { T copy(v); return try_push(std::move(copy)); }
+
+    // Blocks while the queue is full.
+    void push(T v) {
+        if (try_push(std::move(v))) return;
+        producers.waitUntil([&] { return try_push(std::move(v)); });
+    }
+
+    // Blocks while the queue is empty.
+    T pop() {
+        T out;
+        if (!try_pop(out)) consumers.waitUntil([&] { return try_pop(out); });
+        return out;
+    }
+};
+
+// Baseline: ConditionVariableExample's pattern, bounded, as a class.
+template<class T>
+class CondVarQueue {
+    std::mutex mtx;
+    std::condition_variable notEmpty, notFull;
+    std::queue<T> q;
+    std::size_t cap;
+public:
+    explicit CondVarQueue(std::size_t capacity) : cap(capacity) {}
+    void push(T v) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notFull.wait(lock, [&] { return q.size() < cap; });
+            q.push(std::move(v));
+        }
+        notEmpty.notify_one();
+    }
+    T pop() {
+        T v;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notEmpty.wait(lock, [&] { return !q.empty(); });
+            v = std::move(q.front());
+            q.pop();
+        }
+        notFull.notify_one();
+        return v;
+    }
+};
+
+// producers push perProducer items each, consumers pop until they see a
+// poison value; checks that every item arrived once. Returns M items/s.
+template<class Q>
+static double pingThrough(Q& q, unsigned producers, unsigned consumers, std::size_t perProducer) {
+    const std::uint64_t POISON = ~0ULL;
+    std::atomic<std::uint64_t> sum{0}, popped{0};
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> cons, prods;
+    for (unsigned c = 0; c < consumers; ++c)
+        cons.emplace_back([&] {
+            std::uint64_t localSum = 0, localCount = 0;
+            for (std::uint64_t v; (v = q.pop()) != POISON; ++localCount) localSum += v;
+            sum += localSum;
+            popped += localCount;
+        });
+    for (unsigned p = 0; p < producers; ++p)
+        prods.emplace_back([&, p] {
+            for (std::size_t i = 0; i < perProducer; ++i) q.push(static_cast<std::uint64_t>(p) * perProducer + i);
+        });
+    for (auto& t : prods) t.join();
+    for (unsigned c = 0; c < consumers; ++c) q.push(POISON);
+    for (auto& t : cons) t.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::uint64_t total = static_cast<std::uint64_t>(producers) * perProducer;
+    if (popped != total || sum != total * (total - 1) / 2) throw std::runtime_error("lost or duplicated items");
+    return static_cast<double>(total) / sec / 1e6;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== MPMC bounded queue ===\n";
+    MpmcQueue<int> demo(4);
+    for (int i = 1; i <= 5; ++i) std::cout << "try_push(" << i << ") -> " << demo.try_push(i) << '\n';
+    int v;
+    std::cout << "drained:";
+    while (demo.try_pop(v)) std::cout << ' ' << v;
+    std::cout << '\n';
+
+    // Usage: ./MpmcQueue [itemsPerRun] [maxThreadsPerSide] [capacity]
+    std::size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 32;
+    std::size_t cap = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 4096;
+
+    std::cout << "\n" << items << " items per run, capacity " << cap << ", M items/s\n"
+              << std::fixed << std::setprecision(2) << "  producers x consumers   MpmcQueue   mutex+condvar\n";
+    for (unsigned t = 1; t <= maxThreads; t *= 2) {
+        std::size_t perProducer = items / t;
+        MpmcQueue<std::uint64_t> lockFree(cap);
+        CondVarQueue<std::uint64_t> locked(cap);
+        double a = pingThrough(lockFree, t, t, perProducer);
+        double b = pingThrough(locked, t, t, perProducer);
+        std::cout << std::setw(11) << t << " x " << std::setw(2) << t << std::setw(19) << a << std::setw(16) << b << '\n';
+    }
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 MpmcQueue.cpp -o MpmcQueue */
@@ -0,0 +1,481 @@
+/**
+ * @file SegmentedQueue.cpp
+ * @brief Unbounded FIFO queue of linked fixed-size segments that recycles
+ *        drained segments, plus a lock-free multi-producer/single-consumer mode.
+ * @date 2026-10-17
+ *
+ * Queue in QueueImplementation.cpp has a fixed capacity and enqueue() silently
+ * drops the item when it is full. std::queue over std::deque grows without
+ * limit, but it allocates a new block whenever the back crosses a block
+ * boundary and frees the block the front leaves, so even a queue of constant
+ * length keeps calling the allocator.
+ *
+ * SegmentedQueue<T, N> is a singly linked list of segments of N slots each:
+ * - push writes at (tail, tailIdx) and pop reads at (head, headIdx). When the
+ *   tail segment is full a new one is linked behind it. When the head segment
+ *   is drained it is unlinked and put on a free list instead of being deleted.
+ * - New segments come from the free list first, so once the queue has reached
+ *   its peak length it never allocates again. shrink_to_fit() releases the
+ *   spare segments.
+ * - Items are constructed in raw slot storage and destroyed on pop, so T need
+ *   not be default-constructible.
+ *
+ * MpscSegmentedQueue<T, N> is the same idea for many producer threads and one
+ * consumer thread (log lines, events):
+ * - A producer pins the tail segment (users += 1), checks that it is still
+ *   the tail, and claims a slot with one fetch_add on the segment's claim
+ *   counter. It constructs the item and sets the slot's ready flag (release).
+ *   A producer that claims a slot past the end links a next segment if none
+ *   exists yet and swings tail forward.
+ * - The consumer reads slots in order and stops at the first one that is not
+ *   ready yet, so items from one producer come out in the order they were
+ *   pushed.
+ * - A drained segment may still be pinned by a producer that read the old
+ *   tail. The consumer keeps it on a retired list until users == 0. The pin and
+ *   the tail check are seq_cst, so a producer that pins after that point sees
+ *   that the segment is no longer the tail and backs off. The segment is then
+ *   reset and linked after the last segment of the chain as a spare, so
+ *   producers find it ready instead of allocating.
+ * Segments are only deleted by the destructor, so a stale pointer always points
+ * at live memory.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <string>
+#include <algorithm>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+// Counts heap allocations so steady-state behavior can be compared.
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void* operator new(std::size_t size, std::align_val_t al) {
+    std::size_t a = static_cast<std::size_t>(al);
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+constexpr std::size_t CACHE_LINE = 64;
+
+template<class T, std::size_t N = 1024>
+class SegmentedQueue {
+    static_assert(N > 0, "segment must hold at least one item");
+
+    struct Segment {
+        Segment* next = nullptr;
+        alignas(T) unsigned char raw[N * sizeof(T)];
+        T* at(std::size_t i) { return reinterpret_cast<T*>(raw) + i; }
+    };
+
+    Segment* head;
+    Segment* tail;
+    std::size_t headIdx = 0, tailIdx = 0;
+    std::size_t count = 0;
+    Segment* freeList = nullptr;
+    std::size_t spare = 0;
+
+    Segment* takeSegment() {
+        if (!freeList) return new Segment;
+        Segment* s = freeList;
+        freeList = s->next;
+        s->next = nullptr;
+        --spare;
+        return s;
+    }
+
+public:
+    SegmentedQueue() : head(new Segment), tail(head) {}
+    SegmentedQueue(const SegmentedQueue&) = delete;
+    SegmentedQueue& operator=(const SegmentedQueue&) = delete;
+    ~SegmentedQueue() {
+        while (count) pop();
+        delete head;
+        shrink_to_fit();
+    }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    std::size_t spareSegments() const { return spare; }
+
+    void push(T v) {
+        if (tailIdx == N) {
+            Segment* s = takeSegment();
+            tail->next = s;
+            tail = s;
+            tailIdx = 0;
+        }
+        new (tail->at(tailIdx)) T(std::move(v));
+        ++tailIdx;
+        ++count;
+    }
+
+    T& front() {
+        if (count == 0) throw std::out_of_range("SegmentedQueue::front on empty queue");
+        return *head->at(headIdx);
+    }
+
+    void pop() {
+        if (count == 0) throw std::out_of_range("SegmentedQueue::pop on empty queue");
+        head->at(headIdx)->~T();
+        ++headIdx;
+        if (--count == 0) {
+            // Only one segment can be in use when the queue is empty; rewind it.
+            headIdx = tailIdx = 0;
+        } else if (headIdx == N) {
+            Segment* drained = head;
+            head = head->next;
+            headIdx = 0;
+            drained->next = freeList;
+            freeList = drained;
+            ++spare;
+        }
+    }
+
+    bool try_pop(T& out) {
+        if (count == 0) return false;
+        out = std::move(front());
+        pop();
+        return true;
+    }
+
+    // Returns the spare segments to the allocator.
+    void shrink_to_fit() {
+        while (freeList) {
+            Segment* s = freeList;
+            freeList = s->next;
+            delete s;
+        }
+        spare = 0;
+    }
+};
+
+template<class T, std::size_t N = 1024>
+class MpscSegmentedQueue {
+    static_assert(N > 0, "segment must hold at least one item");
+
+    struct Slot {
+        std::atomic<bool> ready{false};
+        alignas(T) unsigned char raw[sizeof(T)];
+        T* item() { return reinterpret_cast<T*>(raw); }
+    };
+
+    struct alignas(CACHE_LINE) Segment {
+        // Producer-written line.
+        std::atomic<std::size_t> claim{0};
+        std::atomic<std::size_t> users{0};
+        std::atomic<Segment*> next{nullptr};
+        // Consumer-private link while the segment waits for users == 0.
+        alignas(CACHE_LINE) Segment* retiredNext = nullptr;
+        Slot slots[N];
+    };
+
+    alignas(CACHE_LINE) std::atomic<Segment*> tail;
+    // Consumer-owned.
+    alignas(CACHE_LINE) Segment* head;
+    std::size_t headIdx = 0;
+    Segment* retired = nullptr;
+    Segment* lastSpare = nullptr;   // most recently linked spare, if not yet consumed
+
+    void linkSpare(Segment* s) {
+        s->claim.store(0, std::memory_order_relaxed);
+        s->next.store(nullptr, std::memory_order_relaxed);
+        Segment* last = lastSpare ? lastSpare : tail.load(std::memory_order_acquire);
+        for (;;) {
+            Segment* n = last->next.load(std::memory_order_acquire);
+            if (n) { last = n; continue; }
+            if (last->next.compare_exchange_weak(n, s, std::memory_order_release, std::memory_order_relaxed)) break;
+        }
+        lastSpare = s;
+    }
+
+    // Links every retired segment that no producer still holds as a spare.
+    void recycleRetired() {
+        Segment** link = &retired;
+        while (Segment* s = *link) {
+            if (s->users.load(std::memory_order_seq_cst) == 0) {
+                *link = s->retiredNext;
+                linkSpare(s);
+            } else {
+                link = &s->retiredNext;
+            }
+        }
+    }
+
+public:
+    MpscSegmentedQueue() : tail(new Segment) { head = tail.load(std::memory_order_relaxed); }
+    MpscSegmentedQueue(const MpscSegmentedQueue&) = delete;
+    MpscSegmentedQueue& operator=(const MpscSegmentedQueue&) = delete;
+    // No producer or consumer may still be running.
+    ~MpscSegmentedQueue() {
+        for (Segment* s = head; s; ) {
+            for (std::size_t i = (s == head ? headIdx : 0); i < N; ++i)
+                if (s->slots[i].ready.load(std::memory_order_relaxed)) s->slots[i].item()->~T();
+            Segment* n = s->next.load(std::memory_order_relaxed);
+            delete s;
+            s = n;
+        }
+        while (retired) {
+            Segment* s = retired;
+            retired = s->retiredNext;
+            delete s;
+        }
+    }
+
+    // Any thread. Never blocks; allocates only when no spare segment is linked.
+    void push(T v) {
+        for (;;) {
+            Segment* s = tail.load(std::memory_order_seq_cst);
+            s->users.fetch_add(1, std::memory_order_seq_cst);
+            if (tail.load(std::memory_order_seq_cst) != s) {
+                s->users.fetch_sub(1, std::memory_order_release);
+                continue;
+            }
+            std::size_t i = s->claim.fetch_add(1, std::memory_order_relaxed);
+            if (i < N) {
+                Slot& slot = s->slots[i];
+                new (slot.item()) T(std::move(v));
+                slot.ready.store(true, std::memory_order_release);
+                s->users.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+            Segment* n = s->next.load(std::memory_order_acquire);
+            if (!n) {
+                Segment* fresh = new Segment;
+                if (s->next.compare_exchange_strong(n, fresh, std::memory_order_acq_rel)) n = fresh;
+                else delete fresh;
+            }
+            Segment* expected = s;
+            tail.compare_exchange_strong(expected, n, std::memory_order_seq_cst);
+            s->users.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // Consumer only. Returns false if the next item in order is not ready yet.
+    bool try_pop(T& out) {
+        if (headIdx == N) {
+            Segment* n = head->next.load(std::memory_order_acquire);
+            if (!n) return false;
+            Segment* drained = head;
+            Segment* expected = drained;
+            tail.compare_exchange_strong(expected, n, std::memory_order_seq_cst);
+            if (lastSpare == n) lastSpare = nullptr;
+            head = n;
+            headIdx = 0;
+            drained->retiredNext = retired;
+            retired = drained;
+            recycleRetired();
+        }
+        Slot& slot = head->slots[headIdx];
+        if (!slot.ready.load(std::memory_order_acquire)) return false;
+        out = std::move(*slot.item());
+        slot.item()->~T();
+        slot.ready.store(false, std::memory_order_relaxed);
+        ++headIdx;
+        return true;
+    }
+};
+
+// Baseline: the original Queue.
+class Queue {
+    std::vector<int> buf;
+    std::size_t head = 0, tail = 0, count = 0;
+public:
+    explicit Queue(std::size_t capacity = 8) : buf(capacity) {}
+    bool empty() const { return count == 0; }
+    bool full() const { return count == buf.size(); }
+    void enqueue(int v) {
+        if (full()) return; // simple
+        buf[tail] = v;
+        tail = (tail + 1) % buf.size();
+        ++count;
+    }
+    void dequeue() {
+        if (empty()) return;
+        head = (head + 1) % buf.size();
+        --count;
+    }
+    int front() const { return buf[head]; }
+};
+
+// Baseline for the MPSC mode: std::queue behind a mutex.
+template<class T>
+class LockedQueue {
+    std::queue<T> q;
+    std::mutex m;
+public:
+    void push(T v) {
+        std::lock_guard<std::mutex> l(m);
+        q.push(std::move(v));
+    }
+    bool try_pop(T& out) {
+        std::lock_guard<std::mutex> l(m);
+        if (q.empty()) return false;
+        out = std::move(q.front());
+        q.pop();
+        return true;
+    }
+};
+
+struct Run { double nsPerOp; std::size_t allocs; std::uint64_t check; };
+
+template<class F>
+static Run measure(std::size_t ops, F&& body) {
+    std::size_t a0 = allocations.load();
+    auto t0 = std::chrono::steady_clock::now();
+    std::uint64_t check = body();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    return {ns / static_cast<double>(ops), allocations.load() - a0, check};
+}
+
+static void printRun(const char* name, const Run& r, const char* extra = "") {
+    std::cout << "  " << std::left << std::setw(24) << name << std::right << std::setw(8) << r.nsPerOp
+              << " ns/op" << std::setw(10) << r.allocs << " allocs" << extra << '\n';
+}
+
+// Producers push (id << 40 | seq); the consumer checks per-producer order.
+template<class Q>
+static Run mpscRun(Q& q, unsigned producers, std::size_t perProducer) {
+    std::size_t total = producers * perProducer;
+    return measure(total, [&] {
+        std::vector<std::thread> threads;
+        for (unsigned p = 0; p < producers; ++p)
+            threads.emplace_back([&, p] {
+                for (std::uint64_t i = 0; i < perProducer; ++i) q.push(static_cast<std::uint64_t>(p) << 40 | i);
+            });
+        std::vector<std::uint64_t> nextSeq(producers, 0);
+        std::uint64_t v;
+        std::size_t got = 0;
+        while (got < total) {
+            if (!q.try_pop(v)) { std::this_thread::yield(); continue; }
+            std::uint64_t& expect = nextSeq[v >> 40];
+            if ((v & ((1ULL << 40) - 1)) != expect++) throw std::runtime_error("producer order violated");
+            ++got;
+        }
+        for (auto& t : threads) t.join();
+        return static_cast<std::uint64_t>(got == total);
+    });
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Segmented queue ===\n";
+    SegmentedQueue<std::string, 4> demo;
+    for (const char* s : {"a", "b", "c", "d", "e", "f", "g", "h", "i"}) demo.push(s);
+    std::cout << "size " << demo.size() << ", popped:";
+    while (!demo.empty()) { std::cout << ' ' << demo.front(); demo.pop(); }
+    std::cout << "\nspare segments after draining: " << demo.spareSegments() << '\n';
+    try { demo.front(); } catch (const std::out_of_range& e) { std::cout << "front(): " << e.what() << '\n'; }
+
+    // Usage: ./SegmentedQueue [ops] [depth] [maxProducers]
+    std::size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    std::size_t depth = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    unsigned maxProducers = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 8;
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Steady state: the queue holds `depth` ints while we push one and pop one.
+    std::cout << "\nsteady state, " << depth << " items queued, " << ops << " push+pop pairs\n";
+    {
+        SegmentedQueue<int> q;
+        for (std::size_t i = 0; i < depth; ++i) q.push(static_cast<int>(i));
+        printRun("SegmentedQueue", measure(ops, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < ops; ++i) { q.push(static_cast<int>(i)); sum += q.front(); q.pop(); }
+            return sum;
+        }));
+    }
+    {
+        std::queue<int> q;
+        for (std::size_t i = 0; i < depth; ++i) q.push(static_cast<int>(i));
+        printRun("std::queue (deque)", measure(ops, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < ops; ++i) { q.push(static_cast<int>(i)); sum += q.front(); q.pop(); }
+            return sum;
+        }));
+    }
+    {
+        Queue q(depth + 1);
+        for (std::size_t i = 0; i < depth; ++i) q.enqueue(static_cast<int>(i));
+        printRun("Queue (capacity depth+1)", measure(ops, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < ops; ++i) { q.enqueue(static_cast<int>(i)); sum += q.front(); q.dequeue(); }
+            return sum;
+        }));
+    }
+
+    // Bursts: fill to 10 * depth, drain, repeat.
+    std::size_t burst = depth * 10, rounds = std::max<std::size_t>(1, ops / burst);
+    std::cout << "\n" << rounds << " bursts of " << burst << " pushes then " << burst << " pops\n";
+    {
+        SegmentedQueue<int> q;
+        printRun("SegmentedQueue", measure(rounds * burst, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < burst; ++i) q.push(static_cast<int>(i));
+                while (!q.empty()) { sum += q.front(); q.pop(); }
+            }
+            return sum;
+        }));
+    }
+    {
+        std::queue<int> q;
+        printRun("std::queue (deque)", measure(rounds * burst, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < burst; ++i) q.push(static_cast<int>(i));
+                while (!q.empty()) { sum += q.front(); q.pop(); }
+            }
+            return sum;
+        }));
+    }
+    {
+        Queue q(depth);
+        std::size_t dropped = 0;
+        Run r = measure(rounds * burst, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < burst; ++i) { dropped += q.full(); q.enqueue(static_cast<int>(i)); }
+                while (!q.empty()) { sum += q.front(); q.dequeue(); }
+            }
+            return sum;
+        });
+        std::string note = "  (dropped " + std::to_string(dropped) + " items)";
+        printRun("Queue (capacity depth)", r, note.c_str());
+    }
+
+    // MPSC: producers push concurrently, one consumer drains.
+    std::cout << "\nMPSC, " << ops << " items per run (allocs include thread start-up)\n";
+    for (unsigned p = 1; p <= maxProducers; p *= 2) {
+        std::cout << " " << p << " producer(s)\n";
+        {
+            MpscSegmentedQueue<std::uint64_t> q;
+            printRun("MpscSegmentedQueue", mpscRun(q, p, ops / p));
+        }
+        {
+            LockedQueue<std::uint64_t> q;
+            printRun("std::queue + mutex", mpscRun(q, p, ops / p));
+        }
+    }
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 SegmentedQueue.cpp -o SegmentedQueue */
@@ -0,0 +1,263 @@
+/**
+ * @file SpscQueue.cpp
+ * @brief Bounded lock-free single-producer/single-consumer ring buffer.
+ * @date 2026-10-17
+ *
+ * Queue in QueueImplementation.cpp is a ring too, but it divides on every
+ * operation, silently drops items when full and cannot be shared between
+ * threads without a lock.
+ *
+ * SpscQueue<T> is the same ring for exactly one producer thread and one
+ * consumer thread:
+ * - Capacity is rounded up to a power of two. head and tail count up forever,
+ *   so the slot is index & mask, and "full" (tail - head == capacity) and
+ *   "empty" (tail == head) need no extra flag.
+ * - Only the producer writes tail and only the consumer writes head. The
+ *   producer publishes a slot with a release store of tail, which the
+ *   consumer's acquire load pairs with, and likewise for head. No CAS, no lock.
+ * - head and tail sit on separate cache lines, and each side keeps a cached
+ *   copy of the other's index on its own line. The shared index is re-read
+ *   only when the cached copy says the ring is full (producer) or empty
+ *   (consumer), so in steady state each side touches only its own line.
+ * - push_n/pop_n move a whole batch with one index update.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+constexpr std::size_t CACHE_LINE = 64;
+
+template<class T>
+class SpscQueue {
+    // Consumer-owned line.
+    alignas(CACHE_LINE) std::atomic<std::size_t> head{0};
+    std::size_t cachedTail = 0;
+    // Producer-owned line.
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail{0};
+    std::size_t cachedHead = 0;
+    // Read-only after construction.
+    alignas(CACHE_LINE) std::size_t mask;
+    std::unique_ptr<T[]> buf;
+
+    static std::size_t roundUp(std::size_t n) {
+        if (n == 0 || n > (SIZE_MAX >> 1) + 1) throw std::invalid_argument("SpscQueue: bad capacity");
+        std::size_t c = 1;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+public:
+    explicit SpscQueue(std::size_t capacity) : mask(roundUp(capacity) - 1), buf(new T[mask + 1]) {}
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+    // Exact only when called from the producer or the consumer while the other is idle.
+    std::size_t size_approx() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+
+    // Producer only. Returns false if the ring is full.
+    bool try_push(T v) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == mask + 1) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == mask + 1) return false;
+        }
+        buf[t & mask] = std::move(v);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Returns false if the ring is empty.
+    bool try_pop(T& out) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) return false;
+        }
+        out = std::move(buf[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only. Pushes up to n items; returns how many fit.
+    std::size_t push_n(const T* items, std::size_t n) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        std::size_t free = mask + 1 - (t - cachedHead);
+        if (free < n) {
+            cachedHead = head.load(std::memory_order_acquire);
+            free = mask + 1 - (t - cachedHead);
+        }
+        n = std::min(n, free);
+        for (std::size_t i = 0; i < n; ++i) buf[(t + i) & mask] = items[i];
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer only. Pops up to n items into out; returns how many.
+    std::size_t pop_n(T* out, std::size_t n) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        std::size_t avail = cachedTail - h;
+        if (avail < n) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            avail = cachedTail - h;
+        }
+        n = std::min(n, avail);
+        for (std::size_t i = 0; i < n; ++i) out[i] = std::move(buf[(h + i) & mask]);
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+};
+
+// Baseline: the original Queue, shared through a mutex.
+class Queue {
+    std::vector<int> buf;
+    std::size_t head = 0, tail = 0, count = 0;
+public:
+    explicit Queue(std::size_t capacity = 8) : buf(capacity) {}
+    bool empty() const { return count == 0; }
+    bool full() const { return count == buf.size(); }
+    void enqueue(int v) {
+        if (full()) return; // simple
+        buf[tail] = v;
+        tail = (tail + 1) % buf.size();
+        ++count;
+    }
+    void dequeue() {
+        if (empty()) return;
+        head = (head + 1) % buf.size();
+        --count;
+    }
+    int front() const { return buf[head]; }
+};
+
+class LockedQueue {
+    Queue q;
+    std::mutex m;
+public:
+    explicit LockedQueue(std::size_t capacity) : q(capacity) {}
+    bool try_push(int v) {
+        std::lock_guard<std::mutex> l(m);
+        if (q.full()) return false;
+        q.enqueue(v);
+        return true;
+    }
+    bool try_pop(int& out) {
+        std::lock_guard<std::mutex> l(m);
+        if (q.empty()) return false;
+        out = q.front();
+        q.dequeue();
+        return true;
+    }
+};
+
+// One producer sends 0..n-1, one consumer checks the order; returns M ops/s.
+template<class Producer, class Consumer>
+static double transfer(std::size_t n, Producer produce, Consumer consume) {
+    auto t0 = std::chrono::steady_clock::now();
+    bool inOrder = true;
+    std::thread consumer([&] { inOrder = consume(n); });
+    produce(n);
+    consumer.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (!inOrder) throw std::runtime_error("items arrived out of order");
+    return static_cast<double>(n) / sec / 1e6;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== SPSC ring buffer ===\n";
+    SpscQueue<int> demo(5);
+    std::cout << "capacity(5) rounds to " << demo.capacity() << '\n';
+    for (int i = 1; i <= 9; ++i)
+        if (!demo.try_push(i)) std::cout << "push " << i << " refused: full\n";
+    int v;
+    std::cout << "popped:";
+    while (demo.try_pop(v)) std::cout << ' ' << v;
+    std::cout << '\n';
+
+    // Usage: ./SpscQueue [items] [capacity] [batch]
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000000;
+    std::size_t cap = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 65536;
+    std::size_t batch = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 256;
+
+    std::cout << "\n" << n << " ints, capacity " << cap << "\n" << std::fixed << std::setprecision(1);
+    {
+        SpscQueue<std::uint32_t> q(cap);
+        double rate = transfer(n,
+            [&](std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i)
+                    while (!q.try_push(static_cast<std::uint32_t>(i))) std::this_thread::yield();
+            },
+            [&](std::size_t count) {
+                std::uint32_t x, expect = 0;
+                bool ok = true;
+                for (std::size_t i = 0; i < count; ++i) {
+                    while (!q.try_pop(x)) std::this_thread::yield();
+                    ok &= x == expect++;
+                }
+                return ok;
+            });
+        std::cout << "  SpscQueue try_push/try_pop   " << std::setw(8) << rate << " M ops/s\n";
+    }
+    {
+        SpscQueue<std::uint32_t> q(cap);
+        double rate = transfer(n,
+            [&](std::size_t count) {
+                std::vector<std::uint32_t> items(batch);
+                for (std::size_t i = 0; i < count;) {
+                    std::size_t k = std::min(batch, count - i);
+                    for (std::size_t j = 0; j < k; ++j) items[j] = static_cast<std::uint32_t>(i + j);
+                    for (std::size_t sent = 0; sent < k;) {
+                        std::size_t m = q.push_n(items.data() + sent, k - sent);
+                        if (m == 0) std::this_thread::yield();
+                        sent += m;
+                    }
+                    i += k;
+                }
+            },
+            [&](std::size_t count) {
+                std::vector<std::uint32_t> out(batch);
+                std::uint32_t expect = 0;
+                bool ok = true;
+                for (std::size_t got = 0; got < count;) {
+                    std::size_t m = q.pop_n(out.data(), batch);
+                    if (m == 0) { std::this_thread::yield(); continue; }
+                    for (std::size_t j = 0; j < m; ++j) ok &= out[j] == expect++;
+                    got += m;
+                }
+                return ok;
+            });
+        std::cout << "  SpscQueue push_n/pop_n (" << batch << ")  " << std::setw(8) << rate << " M ops/s\n";
+    }
+    {
+        LockedQueue q(cap);
+        std::size_t m = std::min<std::size_t>(n, 20000000);
+        double rate = transfer(m,
+            [&](std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i)
+                    while (!q.try_push(static_cast<int>(i))) std::this_thread::yield();
+            },
+            [&](std::size_t count) {
+                int x, expect = 0;
+                bool ok = true;
+                for (std::size_t i = 0; i < count; ++i) {
+                    while (!q.try_pop(x)) std::this_thread::yield();
+                    ok &= x == expect++;
+                }
+                return ok;
+            });
+        std::cout << "  Queue + std::mutex           " << std::setw(8) << rate << " M ops/s (" << m << " ints)\n";
+    }
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 SpscQueue.cpp -o SpscQueue */
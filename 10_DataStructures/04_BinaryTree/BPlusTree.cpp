@@ -0,0 +1,545 @@
+/**
+ * @file BPlusTree.cpp
+ * @brief B+-tree ordered index with cache-line key blocks, SIMD node search,
+ *        linked leaves and bulk loading.
+ * @date 2026-10-17
+ *
+ * BST in BinaryTreeImplementation.cpp allocates one TNode (key + two
+ * unique_ptrs) per key, recurses on every operation, never rebalances (sorted
+ * input gives a linked list) and has neither erase nor range queries.
+ *
+ * BPlusTree<V> maps int keys to values of type V (BPlusTree<> is a set):
+ * - Every node starts with a 64-byte block of 16 sorted int keys; unused slots
+ *   hold INT_MAX. Finding a position is one pass of four SSE2 compares over
+ *   that line and a popcount: no branches, no binary search.
+ * - Inner nodes hold up to 16 separators and 17 children. A separator is
+ *   <= every key in its right subtree and > every key in its left one; after an
+ *   erase it may no longer be present in the leaves, which is harmless.
+ * - Leaves hold up to 16 entries and a next pointer, so range iteration walks
+ *   the leaf chain without touching inner nodes.
+ * - insert() splits full nodes on the way back up; erase() borrows from or
+ *   merges with a sibling when a node drops below half full. Both walk down
+ *   once and remember the path, with no recursion.
+ * - bulkLoad() builds the tree bottom-up from sorted input with every node
+ *   full or nearly so, in O(n).
+ * The tree stays balanced, and every level visit touches one key line.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <limits>
+#include <chrono>
+#include <stdexcept>
+#include <new>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Counts live heap bytes so node layouts can be compared with std::map/std::set.
+static std::size_t liveBytes = 0;
+
+void* operator new(std::size_t size) {
+    liveBytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t size) noexcept { liveBytes -= size; std::free(p); }
+void* operator new(std::size_t size, std::align_val_t al) {
+    std::size_t a = static_cast<std::size_t>(al);
+    liveBytes += size;
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t size, std::align_val_t) noexcept { liveBytes -= size; std::free(p); }
+
+struct Empty {};
+
+template<class V = Empty>
+class BPlusTree {
+public:
+    static constexpr unsigned INNER_KEYS = 16, LEAF_KEYS = 16;
+    static constexpr unsigned MIN_INNER = INNER_KEYS / 2, MIN_LEAF = LEAF_KEYS / 2;
+
+private:
+    static constexpr int PAD = std::numeric_limits<int>::max();
+    static constexpr unsigned MAX_HEIGHT = 32;
+
+    struct Node {};
+
+    struct alignas(64) Leaf : Node {
+        int keys[LEAF_KEYS];
+        V values[LEAF_KEYS];
+        Leaf* next = nullptr;
+        unsigned n = 0;
+        Leaf() { std::fill(keys, keys + LEAF_KEYS, PAD); }
+    };
+
+    struct alignas(64) Inner : Node {
+        int keys[INNER_KEYS];
+        Node* child[INNER_KEYS + 1];
+        unsigned n = 0;   // keys; children = n + 1
+        Inner() { std::fill(keys, keys + INNER_KEYS, PAD); }
+    };
+
+    Node* root = new Leaf;
+    unsigned height = 0;   // inner levels above the leaves
+    std::size_t count = 0;
+
+    // Number of keys < k in a 16-key line (padding never counts).
+    static unsigned countLess(const int* keys, int k) {
+#if defined(__SSE2__)
+        const __m128i* p = reinterpret_cast<const __m128i*>(keys);
+        __m128i x = _mm_set1_epi32(k);
+        __m128i ab = _mm_packs_epi32(_mm_cmplt_epi32(_mm_load_si128(p), x), _mm_cmplt_epi32(_mm_load_si128(p + 1), x));
+        __m128i cd = _mm_packs_epi32(_mm_cmplt_epi32(_mm_load_si128(p + 2), x), _mm_cmplt_epi32(_mm_load_si128(p + 3), x));
+        return static_cast<unsigned>(__builtin_popcount(_mm_movemask_epi8(_mm_packs_epi16(ab, cd))));
+#else
+        unsigned c = 0;
+        for (unsigned i = 0; i < 16; ++i) c += keys[i] < k;
+        return c;
+#endif
+    }
+
+    // Child to descend into for k: the number of separators <= k.
+    static unsigned route(const Inner* in, int k) {
+#if defined(__SSE2__)
+        const __m128i* p = reinterpret_cast<const __m128i*>(in->keys);
+        __m128i x = _mm_set1_epi32(k);
+        __m128i ab = _mm_packs_epi32(_mm_cmpgt_epi32(_mm_load_si128(p), x), _mm_cmpgt_epi32(_mm_load_si128(p + 1), x));
+        __m128i cd = _mm_packs_epi32(_mm_cmpgt_epi32(_mm_load_si128(p + 2), x), _mm_cmpgt_epi32(_mm_load_si128(p + 3), x));
+        unsigned le = 16 - static_cast<unsigned>(__builtin_popcount(_mm_movemask_epi8(_mm_packs_epi16(ab, cd))));
+#else
+        unsigned le = 0;
+        for (unsigned i = 0; i < 16; ++i) le += in->keys[i] <= k;
+#endif
+        return std::min(le, in->n);   // padding matches when k == INT_MAX
+    }
+
+    static void leafInsertAt(Leaf* l, unsigned pos, int k, V v) {
+        for (unsigned j = l->n; j > pos; --j) { l->keys[j] = l->keys[j - 1]; l->values[j] = std::move(l->values[j - 1]); }
+        l->keys[pos] = k;
+        l->values[pos] = std::move(v);
+        ++l->n;
+    }
+
+    static void leafRemoveAt(Leaf* l, unsigned pos) {
+        for (unsigned j = pos + 1; j < l->n; ++j) { l->keys[j - 1] = l->keys[j]; l->values[j - 1] = std::move(l->values[j]); }
+        l->keys[--l->n] = PAD;
+    }
+
+    static void innerRemoveAt(Inner* in, unsigned keyPos, unsigned childPos) {
+        for (unsigned j = keyPos + 1; j < in->n; ++j) in->keys[j - 1] = in->keys[j];
+        for (unsigned j = childPos + 1; j <= in->n; ++j) in->child[j - 1] = in->child[j];
+        in->keys[--in->n] = PAD;
+    }
+
+    // Refills leaf i of p after it dropped below MIN_LEAF.
+    void fixLeaf(Inner* p, unsigned i) {
+        Leaf* l = static_cast<Leaf*>(p->child[i]);
+        Leaf* left = i > 0 ? static_cast<Leaf*>(p->child[i - 1]) : nullptr;
+        Leaf* right = i < p->n ? static_cast<Leaf*>(p->child[i + 1]) : nullptr;
+        if (left && left->n > MIN_LEAF) {
+            leafInsertAt(l, 0, left->keys[left->n - 1], std::move(left->values[left->n - 1]));
+            leafRemoveAt(left, left->n - 1);
+            p->keys[i - 1] = l->keys[0];
+        } else if (right && right->n > MIN_LEAF) {
+            leafInsertAt(l, l->n, right->keys[0], std::move(right->values[0]));
+            leafRemoveAt(right, 0);
+            p->keys[i] = right->keys[0];
+        } else {
+            Leaf* a = left ? left : l;
+            Leaf* b = left ? l : right;
+            for (unsigned j = 0; j < b->n; ++j) { a->keys[a->n + j] = b->keys[j]; a->values[a->n + j] = std::move(b->values[j]); }
+            a->n += b->n;
+            a->next = b->next;
+            delete b;
+            innerRemoveAt(p, left ? i - 1 : i, left ? i : i + 1);
+        }
+    }
+
+    // Refills inner child i of p after it dropped below MIN_INNER.
+    void fixInner(Inner* p, unsigned i) {
+        Inner* in = static_cast<Inner*>(p->child[i]);
+        Inner* left = i > 0 ? static_cast<Inner*>(p->child[i - 1]) : nullptr;
+        Inner* right = i < p->n ? static_cast<Inner*>(p->child[i + 1]) : nullptr;
+        if (left && left->n > MIN_INNER) {
+            for (unsigned j = in->n; j > 0; --j) in->keys[j] = in->keys[j - 1];
+            for (unsigned j = in->n + 1; j > 0; --j) in->child[j] = in->child[j - 1];
+            in->keys[0] = p->keys[i - 1];
+            in->child[0] = left->child[left->n];
+            ++in->n;
+            p->keys[i - 1] = left->keys[left->n - 1];
+            left->keys[--left->n] = PAD;
+        } else if (right && right->n > MIN_INNER) {
+            in->keys[in->n] = p->keys[i];
+            in->child[in->n + 1] = right->child[0];
+            ++in->n;
+            p->keys[i] = right->keys[0];
+            innerRemoveAt(right, 0, 0);
+        } else {
+            Inner* a = left ? left : in;
+            Inner* b = left ? in : right;
+            unsigned sep = left ? i - 1 : i;
+            a->keys[a->n] = p->keys[sep];
+            for (unsigned j = 0; j < b->n; ++j) a->keys[a->n + 1 + j] = b->keys[j];
+            for (unsigned j = 0; j <= b->n; ++j) a->child[a->n + 1 + j] = b->child[j];
+            a->n += 1 + b->n;
+            delete b;
+            innerRemoveAt(p, sep, sep + 1);
+        }
+    }
+
+    static void destroy(Node* n, unsigned h) {
+        if (h == 0) { delete static_cast<Leaf*>(n); return; }
+        Inner* in = static_cast<Inner*>(n);
+        for (unsigned j = 0; j <= in->n; ++j) destroy(in->child[j], h - 1);
+        delete in;
+    }
+
+    const Leaf* leafFor(int k) const {
+        const Node* n = root;
+        for (unsigned h = height; h > 0; --h) {
+            const Inner* in = static_cast<const Inner*>(n);
+            n = in->child[route(in, k)];
+        }
+        return static_cast<const Leaf*>(n);
+    }
+
+public:
+    class iterator {
+        friend class BPlusTree;
+        Leaf* leaf = nullptr;
+        unsigned i = 0;
+        iterator(Leaf* l, unsigned pos) : leaf(l), i(pos) {}
+    public:
+        iterator() = default;
+        int key() const { return leaf->keys[i]; }
+        V& value() const { return leaf->values[i]; }
+        iterator& operator++() {
+            if (++i == leaf->n) { leaf = leaf->next; i = 0; }
+            return *this;
+        }
+        bool operator==(const iterator& o) const { return leaf == o.leaf && i == o.i; }
+        bool operator!=(const iterator& o) const { return !(*this == o); }
+    };
+
+    BPlusTree() = default;
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+    ~BPlusTree() { destroy(root, height); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void clear() {
+        destroy(root, height);
+        root = new Leaf;
+        height = 0;
+        count = 0;
+    }
+
+    // Adds k -> v; returns false (leaving the old value) if k is present.
+    bool insert(int k, V v = V()) {
+        std::pair<Inner*, unsigned> path[MAX_HEIGHT];
+        unsigned depth = 0;
+        Node* n = root;
+        for (unsigned h = height; h > 0; --h) {
+            Inner* in = static_cast<Inner*>(n);
+            unsigned i = route(in, k);
+            path[depth++] = {in, i};
+            n = in->child[i];
+        }
+        Leaf* leaf = static_cast<Leaf*>(n);
+        unsigned pos = countLess(leaf->keys, k);
+        if (pos < leaf->n && leaf->keys[pos] == k) return false;
+        ++count;
+        if (leaf->n < LEAF_KEYS) { leafInsertAt(leaf, pos, k, std::move(v)); return true; }
+
+        // Split the full leaf: the lower half stays, the upper half moves right.
+        Leaf* right = new Leaf;
+        unsigned keep = (LEAF_KEYS + 1) / 2;
+        bool goesLeft = pos < keep;
+        unsigned from = goesLeft ? keep - 1 : keep;
+        for (unsigned j = from; j < LEAF_KEYS; ++j) {
+            right->keys[j - from] = leaf->keys[j];
+            right->values[j - from] = std::move(leaf->values[j]);
+            leaf->keys[j] = PAD;
+        }
+        right->n = LEAF_KEYS - from;
+        leaf->n = from;
+        if (goesLeft) leafInsertAt(leaf, pos, k, std::move(v)); else leafInsertAt(right, pos - from, k, std::move(v));
+        right->next = leaf->next;
+        leaf->next = right;
+
+        // Push the separator up, splitting full inner nodes on the way.
+        int sep = right->keys[0];
+        Node* newChild = right;
+        while (depth > 0) {
+            auto [p, i] = path[--depth];
+            if (p->n < INNER_KEYS) {
+                for (unsigned j = p->n; j > i; --j) p->keys[j] = p->keys[j - 1];
+                for (unsigned j = p->n + 1; j > i + 1; --j) p->child[j] = p->child[j - 1];
+                p->keys[i] = sep;
+                p->child[i + 1] = newChild;
+                ++p->n;
+                return true;
+            }
+            int keys[INNER_KEYS + 1];
+            Node* child[INNER_KEYS + 2];
+            for (unsigned j = 0, s = 0; j <= INNER_KEYS; ++j) keys[j] = j == i ? sep : p->keys[s++];
+            for (unsigned j = 0, s = 0; j <= INNER_KEYS + 1; ++j) child[j] = j == i + 1 ? newChild : p->child[s++];
+            unsigned mid = (INNER_KEYS + 1) / 2;
+            Inner* r = new Inner;
+            std::fill(p->keys, p->keys + INNER_KEYS, PAD);
+            std::copy(keys, keys + mid, p->keys);
+            std::copy(child, child + mid + 1, p->child);
+            p->n = mid;
+            std::copy(keys + mid + 1, keys + INNER_KEYS + 1, r->keys);
+            std::copy(child + mid + 1, child + INNER_KEYS + 2, r->child);
+            r->n = INNER_KEYS - mid;
+            sep = keys[mid];
+            newChild = r;
+        }
+        Inner* top = new Inner;
+        top->n = 1;
+        top->keys[0] = sep;
+        top->child[0] = root;
+        top->child[1] = newChild;
+        root = top;
+        ++height;
+        return true;
+    }
+
+    // Removes k; returns false if it was not present.
+    bool erase(int k) {
+        std::pair<Inner*, unsigned> path[MAX_HEIGHT];
+        unsigned depth = 0;
+        Node* n = root;
+        for (unsigned h = height; h > 0; --h) {
+            Inner* in = static_cast<Inner*>(n);
+            unsigned i = route(in, k);
+            path[depth++] = {in, i};
+            n = in->child[i];
+        }
+        Leaf* leaf = static_cast<Leaf*>(n);
+        unsigned pos = countLess(leaf->keys, k);
+        if (pos >= leaf->n || leaf->keys[pos] != k) return false;
+        leafRemoveAt(leaf, pos);
+        --count;
+
+        // Walk up while the node just changed is underfull.
+        bool underfull = leaf->n < MIN_LEAF;
+        for (unsigned level = 0; underfull && depth > 0; ++level) {
+            auto [p, i] = path[--depth];
+            if (level == 0) fixLeaf(p, i); else fixInner(p, i);
+            underfull = p->n < MIN_INNER;
+        }
+        if (height > 0 && static_cast<Inner*>(root)->n == 0) {
+            Inner* old = static_cast<Inner*>(root);
+            root = old->child[0];
+            delete old;
+            --height;
+        }
+        return true;
+    }
+
+    V* find(int k) {
+        Leaf* l = const_cast<Leaf*>(leafFor(k));
+        unsigned pos = countLess(l->keys, k);
+        return pos < l->n && l->keys[pos] == k ? &l->values[pos] : nullptr;
+    }
+    bool contains(int k) const {
+        const Leaf* l = leafFor(k);
+        unsigned pos = countLess(l->keys, k);
+        return pos < l->n && l->keys[pos] == k;
+    }
+
+    // First entry with key >= k, or end().
+    iterator lower_bound(int k) const {
+        Leaf* l = const_cast<Leaf*>(leafFor(k));
+        unsigned pos = countLess(l->keys, k);
+        if (pos == l->n) { l = l->next; pos = 0; }
+        return iterator(l, pos);
+    }
+    iterator begin() const { return lower_bound(std::numeric_limits<int>::min()); }
+    iterator end() const { return iterator(); }
+
+    // Calls fn(key, value) for every key in [lo, hi), in order.
+    template<class F>
+    void forRange(int lo, int hi, F&& fn) const {
+        for (iterator it = lower_bound(lo); it != end() && it.key() < hi; ++it) fn(it.key(), it.value());
+    }
+
+    // Replaces the contents with strictly increasing keys (values optional).
+    void bulkLoad(const std::vector<int>& keys, const std::vector<V>& values = {}) {
+        if (!values.empty() && values.size() != keys.size()) throw std::invalid_argument("BPlusTree::bulkLoad: size mismatch");
+        for (std::size_t j = 1; j < keys.size(); ++j)
+            if (keys[j - 1] >= keys[j]) throw std::invalid_argument("BPlusTree::bulkLoad: keys not strictly increasing");
+        clear();
+        if (keys.empty()) return;
+        delete static_cast<Leaf*>(root);
+
+        // Spread entries evenly so every node but the root is at least half full.
+        std::vector<Node*> level;
+        std::vector<int> mins;
+        std::size_t nLeaves = (keys.size() + LEAF_KEYS - 1) / LEAF_KEYS, at = 0;
+        Leaf* prev = nullptr;
+        for (std::size_t j = 0; j < nLeaves; ++j) {
+            std::size_t take = keys.size() / nLeaves + (j < keys.size() % nLeaves);
+            Leaf* l = new Leaf;
+            for (std::size_t t = 0; t < take; ++t, ++at) {
+                l->keys[t] = keys[at];
+                if (!values.empty()) l->values[t] = values[at];
+            }
+            l->n = static_cast<unsigned>(take);
+            if (prev) prev->next = l;
+            prev = l;
+            level.push_back(l);
+            mins.push_back(l->keys[0]);
+        }
+        height = 0;
+        while (level.size() > 1) {
+            std::vector<Node*> up;
+            std::vector<int> upMins;
+            std::size_t groups = (level.size() + INNER_KEYS) / (INNER_KEYS + 1);
+            at = 0;
+            for (std::size_t g = 0; g < groups; ++g) {
+                std::size_t take = level.size() / groups + (g < level.size() % groups);
+                Inner* in = new Inner;
+                for (std::size_t c = 0; c < take; ++c) {
+                    in->child[c] = level[at + c];
+                    if (c > 0) in->keys[c - 1] = mins[at + c];
+                }
+                in->n = static_cast<unsigned>(take - 1);
+                up.push_back(in);
+                upMins.push_back(mins[at]);
+                at += take;
+            }
+            level.swap(up);
+            mins.swap(upMins);
+            ++height;
+        }
+        root = level[0];
+        count = keys.size();
+    }
+
+    unsigned depth() const { return height + 1; }
+};
+
+static std::uint64_t splitmix(std::uint64_t& s) {
+    std::uint64_t z = (s += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Random inserts, lookups, a full scan, short range scans and erases on one
+// ordered container; Add/Find/Scan/Range/Erase adapt the container's API.
+struct Row { double insertMs, memoryMb, lookupMs, scanMs, rangeMs, eraseMs; std::size_t checksum; };
+
+template<class C, class Add, class Find, class Scan, class Range, class Erase>
+static Row measure(const std::vector<int>& keys, const std::vector<int>& probes, Add add, Find find, Scan scan,
+                   Range range, Erase erase) {
+    Row r{};
+    std::size_t before = liveBytes;
+    C c;
+    r.insertMs = timeMs([&] { for (int k : keys) add(c, k); });
+    r.memoryMb = static_cast<double>(liveBytes - before) / 1e6;
+    r.lookupMs = timeMs([&] { for (int k : probes) r.checksum += find(c, k); });
+    r.scanMs = timeMs([&] { r.checksum += scan(c); });
+    r.rangeMs = timeMs([&] { for (std::size_t i = 0; i < probes.size(); i += 16) r.checksum += range(c, probes[i]); });
+    r.eraseMs = timeMs([&] { for (std::size_t i = 0; i < keys.size(); i += 2) erase(c, keys[i]); });
+    return r;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== B+-tree ===\n";
+    BPlusTree<int> demo;
+    for (int k : {5, 3, 7, 2, 4, 6, 8}) demo.insert(k, k * k);
+    demo.erase(4);
+    std::cout << "in order:";
+    for (auto it = demo.begin(); it != demo.end(); ++it) std::cout << ' ' << it.key() << "->" << it.value();
+    std::cout << "\nlower_bound(4) = " << demo.lower_bound(4).key() << ", contains 4? " << demo.contains(4) << '\n';
+
+    // Usage: ./BPlusTree [keys]
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::uint64_t seed = 42;
+    std::vector<int> keys(n), probes(n);
+    for (auto& k : keys) k = static_cast<int>(splitmix(seed) >> 33);
+    for (std::size_t i = 0; i < n; ++i) probes[i] = i % 2 ? keys[splitmix(seed) % n] : static_cast<int>(splitmix(seed) >> 33);
+
+    // Short range query: up to 100 keys starting at lo.
+    auto rangeB = [](auto& t, int lo) { std::size_t s = 0, m = 0; for (auto it = t.lower_bound(lo); it != t.end() && m < 100; ++it, ++m) s += static_cast<unsigned>(it.key()); return s; };
+    auto rangeS = [](auto& t, int lo) { std::size_t s = 0, m = 0; for (auto it = t.lower_bound(lo); it != t.end() && m < 100; ++it, ++m) s += static_cast<unsigned>(*it); return s; };
+    auto rangeM = [](auto& t, int lo) { std::size_t s = 0, m = 0; for (auto it = t.lower_bound(lo); it != t.end() && m < 100; ++it, ++m) s += static_cast<unsigned>(it->first); return s; };
+
+    Row rows[4] = {
+        measure<BPlusTree<int>>(keys, probes,
+            [](auto& t, int k) { t.insert(k, k); }, [](auto& t, int k) { return t.find(k) != nullptr; },
+            [](auto& t) { std::size_t s = 0; for (auto it = t.begin(); it != t.end(); ++it) s += static_cast<unsigned>(it.value()); return s; },
+            rangeB, [](auto& t, int k) { t.erase(k); }),
+        measure<std::map<int, int>>(keys, probes,
+            [](auto& t, int k) { t.emplace(k, k); }, [](auto& t, int k) { return t.find(k) != t.end(); },
+            [](auto& t) { std::size_t s = 0; for (auto& kv : t) s += static_cast<unsigned>(kv.second); return s; },
+            rangeM, [](auto& t, int k) { t.erase(k); }),
+        measure<BPlusTree<>>(keys, probes,
+            [](auto& t, int k) { t.insert(k); }, [](auto& t, int k) { return t.contains(k); },
+            [](auto& t) { std::size_t s = 0; for (auto it = t.begin(); it != t.end(); ++it) s += static_cast<unsigned>(it.key()); return s; },
+            rangeB, [](auto& t, int k) { t.erase(k); }),
+        measure<std::set<int>>(keys, probes,
+            [](auto& t, int k) { t.insert(k); }, [](auto& t, int k) { return t.count(k) != 0; },
+            [](auto& t) { std::size_t s = 0; for (int k : t) s += static_cast<unsigned>(k); return s; },
+            rangeS, [](auto& t, int k) { t.erase(k); }),
+    };
+    if (rows[0].checksum != rows[1].checksum || rows[2].checksum != rows[3].checksum) {
+        std::cerr << "checksum mismatch\n";
+        return 1;
+    }
+
+    std::cout << "\n" << n << " random int keys\n" << std::fixed << std::setprecision(0)
+              << "                      B+ map   std::map     B+ set   std::set\n";
+    auto line = [&](const char* name, double Row::*field) {
+        std::cout << std::setw(18) << name;
+        for (const Row& r : rows) std::cout << std::setw(11) << r.*field;
+        std::cout << '\n';
+    };
+    line("insert (ms)", &Row::insertMs);
+    line("memory (MB)", &Row::memoryMb);
+    line("find (ms)", &Row::lookupMs);
+    line("full scan (ms)", &Row::scanMs);
+    line("100-key ranges", &Row::rangeMs);
+    line("erase half (ms)", &Row::eraseMs);
+
+    // Sorted input: bulk load vs. one-by-one inserts (which never degrade here).
+    std::vector<int> sorted(keys);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    BPlusTree<> bulk, oneByOne;
+    std::set<int> hinted;
+    double bulkMs = timeMs([&] { bulk.bulkLoad(sorted); });
+    double seqMs = timeMs([&] { for (int k : sorted) oneByOne.insert(k); });
+    double setMs = timeMs([&] { for (int k : sorted) hinted.insert(hinted.end(), k); });
+    std::cout << "\n" << sorted.size() << " sorted keys: bulkLoad " << bulkMs << " ms (depth " << bulk.depth()
+              << "), B+ insert " << seqMs << " ms (depth " << oneByOne.depth() << "), std::set hinted insert "
+              << setMs << " ms\n";
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 BPlusTree.cpp -o BPlusTree */
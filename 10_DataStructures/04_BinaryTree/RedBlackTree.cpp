@@ -0,0 +1,386 @@
+/**
+ * @file RedBlackTree.cpp
+ * @brief Arena-backed red-black tree with iterative insert/search/erase and
+ *        order statistics (rank/select).
+ * @date 2026-10-17
+ *
+ * BST in BinaryTreeImplementation.cpp never rebalances: inserting sorted keys
+ * builds a path of depth n, every insertRec call adds a stack frame, and around
+ * 10^5 sorted keys it overflows the stack. Its destructor also recurses through
+ * one unique_ptr per node.
+ *
+ * RedBlackTree keeps the classic red-black invariants (CLRS ch. 13), so depth
+ * stays below 2 log2(n + 1):
+ * - Nodes live in a std::vector arena and link to each other by 32-bit index.
+ *   Index 0 is the black NIL sentinel, which removes the null checks from the
+ *   fix-up code. Erased slots go on a free list and are reused by later
+ *   inserts. Destroying the tree releases the vector in one step.
+ * - insert, contains and erase are loops over parent links; no recursion.
+ * - Every node stores the size of its subtree, maintained through the
+ *   rotations, so rank(k) (keys < k) and select(i) (i-th smallest) walk a
+ *   single root-to-leaf path.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <set>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+class RedBlackTree {
+    static constexpr std::uint32_t NIL = 0;
+
+    struct Node {
+        int key = 0;
+        std::uint32_t left = NIL, right = NIL, parent = NIL;
+        std::uint32_t size = 0;   // nodes in this subtree; 0 for NIL
+        bool red = false;
+    };
+
+    std::vector<Node> arena{Node{}};   // arena[0] is NIL
+    std::uint32_t root = NIL;
+    std::uint32_t freeList = NIL;      // chained through left
+
+    Node& at(std::uint32_t i) { return arena[i]; }
+    const Node& at(std::uint32_t i) const { return arena[i]; }
+
+    std::uint32_t allocate(int key) {
+        std::uint32_t i;
+        if (freeList != NIL) {
+            i = freeList;
+            freeList = arena[i].left;
+        } else {
+            if (arena.size() > UINT32_MAX - 1) throw std::length_error("RedBlackTree: arena full");
+            i = static_cast<std::uint32_t>(arena.size());
+            arena.emplace_back();
+        }
+        Node& n = arena[i];
+        n.key = key;
+        n.left = n.right = n.parent = NIL;
+        n.size = 1;
+        n.red = true;
+        return i;
+    }
+
+    void release(std::uint32_t i) {
+        arena[i].left = freeList;
+        freeList = i;
+    }
+
+    void rotateLeft(std::uint32_t x) {
+        std::uint32_t y = at(x).right;
+        at(x).right = at(y).left;
+        if (at(y).left != NIL) at(at(y).left).parent = x;
+        replaceChild(at(x).parent, x, y);
+        at(y).left = x;
+        at(x).parent = y;
+        at(y).size = at(x).size;
+        at(x).size = at(at(x).left).size + at(at(x).right).size + 1;
+    }
+
+    void rotateRight(std::uint32_t x) {
+        std::uint32_t y = at(x).left;
+        at(x).left = at(y).right;
+        if (at(y).right != NIL) at(at(y).right).parent = x;
+        replaceChild(at(x).parent, x, y);
+        at(y).right = x;
+        at(x).parent = y;
+        at(y).size = at(x).size;
+        at(x).size = at(at(x).left).size + at(at(x).right).size + 1;
+    }
+
+    // Makes v take u's place under parent p (v may be NIL).
+    void replaceChild(std::uint32_t p, std::uint32_t u, std::uint32_t v) {
+        if (p == NIL) root = v;
+        else if (at(p).left == u) at(p).left = v;
+        else at(p).right = v;
+        at(v).parent = p;
+    }
+
+    std::uint32_t findNode(int k) const {
+        std::uint32_t n = root;
+        while (n != NIL && at(n).key != k) n = k < at(n).key ? at(n).left : at(n).right;
+        return n;
+    }
+
+    void insertFixup(std::uint32_t z) {
+        while (at(at(z).parent).red) {
+            std::uint32_t p = at(z).parent, g = at(p).parent;
+            bool leftSide = p == at(g).left;
+            std::uint32_t uncle = leftSide ? at(g).right : at(g).left;
+            if (at(uncle).red) {
+                at(p).red = at(uncle).red = false;
+                at(g).red = true;
+                z = g;
+                continue;
+            }
+            if (z == (leftSide ? at(p).right : at(p).left)) {
+                z = p;
+                leftSide ? rotateLeft(z) : rotateRight(z);
+                p = at(z).parent;
+            }
+            at(p).red = false;
+            at(g).red = true;
+            leftSide ? rotateRight(g) : rotateLeft(g);
+        }
+        at(root).red = false;
+    }
+
+    void eraseFixup(std::uint32_t x) {
+        while (x != root && !at(x).red) {
+            std::uint32_t p = at(x).parent;
+            bool leftSide = x == at(p).left;
+            std::uint32_t w = leftSide ? at(p).right : at(p).left;
+            if (at(w).red) {
+                at(w).red = false;
+                at(p).red = true;
+                leftSide ? rotateLeft(p) : rotateRight(p);
+                w = leftSide ? at(p).right : at(p).left;
+            }
+            std::uint32_t nearChild = leftSide ? at(w).left : at(w).right;
+            std::uint32_t farChild = leftSide ? at(w).right : at(w).left;
+            if (!at(nearChild).red && !at(farChild).red) {
+                at(w).red = true;
+                x = p;
+                continue;
+            }
+            if (!at(farChild).red) {
+                at(nearChild).red = false;
+                at(w).red = true;
+                leftSide ? rotateRight(w) : rotateLeft(w);
+                w = leftSide ? at(p).right : at(p).left;
+            }
+            at(w).red = at(p).red;
+            at(p).red = false;
+            at(leftSide ? at(w).right : at(w).left).red = false;
+            leftSide ? rotateLeft(p) : rotateRight(p);
+            x = root;
+        }
+        at(x).red = false;
+    }
+
+public:
+    std::size_t size() const { return at(root).size; }
+    bool empty() const { return root == NIL; }
+
+    // Pre-sizes the arena for n nodes.
+    void reserve(std::size_t n) { arena.reserve(n + 1); }
+
+    void clear() {
+        arena.assign(1, Node{});
+        root = freeList = NIL;
+    }
+
+    // Returns false if k was already present.
+    bool insert(int k) {
+        std::uint32_t parent = NIL, n = root;
+        while (n != NIL) {
+            if (k == at(n).key) return false;
+            parent = n;
+            n = k < at(n).key ? at(n).left : at(n).right;
+        }
+        std::uint32_t z = allocate(k);
+        at(z).parent = parent;
+        if (parent == NIL) root = z;
+        else if (k < at(parent).key) at(parent).left = z;
+        else at(parent).right = z;
+        for (std::uint32_t p = parent; p != NIL; p = at(p).parent) ++at(p).size;
+        insertFixup(z);
+        return true;
+    }
+
+    bool contains(int k) const { return findNode(k) != NIL; }
+
+    // Returns false if k was not present.
+    bool erase(int k) {
+        std::uint32_t z = findNode(k);
+        if (z == NIL) return false;
+        // y is the node that physically leaves its position: z, or z's successor.
+        std::uint32_t y = z;
+        if (at(z).left != NIL && at(z).right != NIL) {
+            y = at(z).right;
+            while (at(y).left != NIL) y = at(y).left;
+        }
+        for (std::uint32_t p = at(y).parent; p != NIL; p = at(p).parent) --at(p).size;
+
+        bool removedRed = at(y).red;
+        std::uint32_t x = at(y).left != NIL ? at(y).left : at(y).right;
+        std::uint32_t xParent = at(y).parent == z ? y : at(y).parent;
+        replaceChild(at(y).parent, y, x);
+        if (y != z) {
+            // Move y into z's position, taking over its links, color and size.
+            at(x).parent = xParent;
+            at(y).left = at(z).left;
+            at(y).right = at(z).right;
+            at(at(y).left).parent = y;
+            at(at(y).right).parent = y;
+            replaceChild(at(z).parent, z, y);
+            at(y).red = at(z).red;
+            at(y).size = at(z).size;
+        }
+        if (!removedRed) eraseFixup(x);
+        at(NIL).parent = NIL;
+        at(NIL).red = false;
+        release(z);
+        return true;
+    }
+
+    // Number of keys < k.
+    std::size_t rank(int k) const {
+        std::size_t r = 0;
+        for (std::uint32_t n = root; n != NIL;) {
+            if (k <= at(n).key) n = at(n).left;
+            else { r += at(at(n).left).size + 1; n = at(n).right; }
+        }
+        return r;
+    }
+
+    // The i-th smallest key, 0-based.
+    int select(std::size_t i) const {
+        if (i >= size()) throw std::out_of_range("RedBlackTree::select");
+        std::uint32_t n = root;
+        for (;;) {
+            std::size_t leftSize = at(at(n).left).size;
+            if (i < leftSize) n = at(n).left;
+            else if (i == leftSize) return at(n).key;
+            else { i -= leftSize + 1; n = at(n).right; }
+        }
+    }
+
+    // Longest root-to-leaf path, in nodes.
+    std::size_t height() const {
+        std::size_t h = 0;
+        std::vector<std::pair<std::uint32_t, std::size_t>> stack;
+        if (root != NIL) stack.emplace_back(root, 1);
+        while (!stack.empty()) {
+            auto [n, d] = stack.back();
+            stack.pop_back();
+            h = std::max(h, d);
+            if (at(n).left != NIL) stack.emplace_back(at(n).left, d + 1);
+            if (at(n).right != NIL) stack.emplace_back(at(n).right, d + 1);
+        }
+        return h;
+    }
+
+    void inorder() const {
+        std::vector<std::uint32_t> stack;
+        std::uint32_t n = root;
+        while (n != NIL || !stack.empty()) {
+            for (; n != NIL; n = at(n).left) stack.push_back(n);
+            n = stack.back();
+            stack.pop_back();
+            std::cout << at(n).key << ' ';
+            n = at(n).right;
+        }
+        std::cout << '\n';
+    }
+};
+
+// Baseline: the original recursive, unbalanced BST.
+struct TNode {
+    int key;
+    std::unique_ptr<TNode> left, right;
+    explicit TNode(int k) : key(k) {}
+};
+
+class BST {
+    std::unique_ptr<TNode> root;
+    void insertRec(std::unique_ptr<TNode>& node, int k) {
+        if (!node) { node = std::make_unique<TNode>(k); return; }
+        if (k < node->key) insertRec(node->left, k); else if (k > node->key) insertRec(node->right, k);
+    }
+    bool searchRec(TNode* node, int k) const {
+        if (!node) return false;
+        if (node->key == k) return true;
+        return k < node->key ? searchRec(node->left.get(), k) : searchRec(node->right.get(), k);
+    }
+public:
+    void insert(int k) { insertRec(root, k); }
+    bool contains(int k) const { return searchRec(root.get(), k); }
+};
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Red-black tree ===\n";
+    RedBlackTree tree;
+    for (int k : {5, 3, 7, 2, 4, 6, 8}) tree.insert(k);
+    tree.erase(3);
+    tree.inorder();
+    std::cout << "rank(6) = " << tree.rank(6) << ", select(0) = " << tree.select(0) << ", contains 3? " << tree.contains(3) << '\n';
+
+    // Usage: ./RedBlackTree [keys] [bstSortedKeys]
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t bstSorted = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+    std::uint64_t s = 88172645463325252ULL;
+    std::vector<int> random(n);
+    for (auto& k : random) { s ^= s << 13; s ^= s >> 7; s ^= s << 17; k = static_cast<int>(s >> 33); }
+
+    std::cout << std::fixed << std::setprecision(1) << "\n" << n << " sorted inserts\n";
+    {
+        auto rb = std::make_unique<RedBlackTree>();
+        std::set<int> set;
+        double rbMs = timeMs([&] { for (std::size_t i = 0; i < n; ++i) rb->insert(static_cast<int>(i)); });
+        double setMs = timeMs([&] { for (std::size_t i = 0; i < n; ++i) set.insert(static_cast<int>(i)); });
+        std::cout << "  RedBlackTree " << rbMs << " ms (height " << rb->height() << "), std::set " << setMs << " ms\n";
+        BST bst;
+        double bstMs = timeMs([&] { for (std::size_t i = 0; i < bstSorted; ++i) bst.insert(static_cast<int>(i)); });
+        std::cout << "  BST needs " << bstMs << " ms for only " << bstSorted << " sorted keys (height " << bstSorted
+                  << ", one stack frame per level)\n";
+        double rbFree = timeMs([&] { rb.reset(); });
+        double setFree = timeMs([&] { std::set<int>().swap(set); });
+        std::cout << "  destroy: RedBlackTree " << rbFree << " ms, std::set " << setFree << " ms\n";
+    }
+
+    std::cout << "\n" << n << " random keys\n";
+    {
+        auto rb = std::make_unique<RedBlackTree>();
+        auto bst = std::make_unique<BST>();
+        std::set<int> set;
+        double rbIns = timeMs([&] { for (int k : random) rb->insert(k); });
+        double bstIns = timeMs([&] { for (int k : random) bst->insert(k); });
+        double setIns = timeMs([&] { for (int k : random) set.insert(k); });
+        std::size_t hits[3] = {};
+        double rbFind = timeMs([&] { for (std::size_t i = 0; i < n; ++i) hits[0] += rb->contains(random[i] ^ static_cast<int>(i & 1)); });
+        double bstFind = timeMs([&] { for (std::size_t i = 0; i < n; ++i) hits[1] += bst->contains(random[i] ^ static_cast<int>(i & 1)); });
+        double setFind = timeMs([&] { for (std::size_t i = 0; i < n; ++i) hits[2] += set.count(random[i] ^ static_cast<int>(i & 1)); });
+        if (hits[0] != hits[1] || hits[0] != hits[2] || rb->size() != set.size()) { std::cerr << "mismatch\n"; return 1; }
+
+        // rank/select round trip, then erase half.
+        std::size_t bad = 0;
+        std::size_t q = std::min<std::size_t>(n, 1000000);
+        double rsMs = timeMs([&] { for (std::size_t i = 0; i < q; ++i) { std::size_t r = (i * 2654435761u) % rb->size(); bad += rb->rank(rb->select(r)) != r; } });
+        double rbErase = timeMs([&] { for (std::size_t i = 0; i < n; i += 2) rb->erase(random[i]); });
+        double setErase = timeMs([&] { for (std::size_t i = 0; i < n; i += 2) set.erase(random[i]); });
+        if (bad || rb->size() != set.size()) { std::cerr << "rank/select or erase mismatch\n"; return 1; }
+        double rbFree = timeMs([&] { rb.reset(); });
+        double bstFree = timeMs([&] { bst.reset(); });
+        double setFree = timeMs([&] { std::set<int>().swap(set); });
+
+        auto row = [](const char* name, double a, double b, double c) {
+            std::cout << std::setw(14) << name << std::setw(14) << a << std::setw(11);
+            if (b < 0) std::cout << '-'; else std::cout << b;
+            std::cout << std::setw(11) << c << '\n';
+        };
+        std::cout << "                RedBlackTree        BST   std::set   (ms)\n";
+        row("insert", rbIns, bstIns, setIns);
+        row("contains", rbFind, bstFind, setFind);
+        row("erase half", rbErase, -1, setErase);
+        row("destroy", rbFree, bstFree, setFree);
+        std::cout << "  " << q << " select+rank pairs: " << rsMs << " ms\n";
+    }
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 RedBlackTree.cpp -o RedBlackTree */
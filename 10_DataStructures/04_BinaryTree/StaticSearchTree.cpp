@@ -0,0 +1,320 @@
+/**
+ * @file StaticSearchTree.cpp
+ * @brief Build-once search tree in Eytzinger or van Emde Boas layout with
+ *        branchless lower_bound, prefetching and batched lookups.
+ * @date 2026-10-17
+ *
+ * A BST that is built once and then only queried still pays for its pointer
+ * layout on every lookup: each level is a dependent load from a random heap
+ * address, and the branch on each comparison is a coin flip. std::lower_bound
+ * on a sorted array removes the pointers, but its first probes land far apart,
+ * so a lookup spends about one cache miss per level.
+ *
+ * StaticSearchTree stores the same keys as an implicit complete binary tree:
+ * - Eytzinger (BFS) order: the root at index 1 and the children of k at 2k and
+ *   2k + 1. The descent is k = 2k + (key[k] < x), with no branch to mispredict,
+ *   and the answer is recovered from k by stripping trailing right turns.
+ *   All 16 descendants of k four levels down (64 / sizeof(T) in general) share
+ *   one cache line at index 16k, so each step prefetches that line and the
+ *   miss overlaps with the next four comparisons.
+ * - van Emde Boas order: the tree is split at half its height into a top tree
+ *   and its bottom trees, each stored contiguously and laid out the same way
+ *   recursively, so a root-to-leaf path touches O(log_B n) blocks for every
+ *   block size B. Positions come from per-depth tables (Brodal, Fagerberg and
+ *   Jacob, 2002); the tree is padded to a full 2^h - 1 nodes.
+ * - lower_bound_many() advances up to 16 independent lookups one level at a
+ *   time, so their cache misses are outstanding together instead of one by
+ *   one.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <chrono>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+template<class T = int>
+class StaticSearchTree {
+public:
+    enum class Layout { Eytzinger, VanEmdeBoas };
+
+private:
+    static constexpr std::size_t LINE = 64;
+    static constexpr std::size_t STRIDE = LINE / sizeof(T) > 1 ? LINE / sizeof(T) : 1;   // descendants per line
+    static constexpr std::size_t BATCH = 16;
+    static constexpr unsigned MAX_HEIGHT = 64;
+
+    struct FreeDeleter { void operator()(T* p) const { std::free(p); } };
+
+    Layout layout;
+    std::size_t n = 0;          // real keys
+    std::size_t slots = 0;      // stored keys (padded for van Emde Boas)
+    unsigned height = 0;        // levels of the implicit tree
+    std::unique_ptr<T, FreeDeleter> storage;
+    T maxKey{};
+    // van Emde Boas split of the depth that roots a bottom tree.
+    struct Split {
+        std::size_t topSize = 0, bottomSize = 0;
+        unsigned topDepth = 0;
+    };
+    std::vector<Split> splits;   // indexed by depth
+
+    static void prefetch(const T* base, std::size_t index) {
+        // Integer arithmetic: the prefetched line may lie past the array.
+        __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(base) + index * sizeof(T)));
+    }
+
+    void allocate(std::size_t count) {
+        std::size_t bytes = (count * sizeof(T) + LINE - 1) / LINE * LINE;
+        T* p = static_cast<T*>(std::aligned_alloc(LINE, bytes ? bytes : LINE));
+        if (!p) throw std::bad_alloc();
+        storage.reset(p);
+    }
+
+    // Writes sorted keys into BFS slots 1..count of out by in-order traversal.
+    static void fillEytzinger(const T* sorted, std::size_t count, T* out, std::size_t k, std::size_t& next) {
+        if (k > count) return;
+        fillEytzinger(sorted, count, out, 2 * k, next);
+        out[k] = sorted[next++];
+        fillEytzinger(sorted, count, out, 2 * k + 1, next);
+    }
+
+    // Records, for every depth that roots a bottom tree, the sizes of the split.
+    void splitTables(unsigned depth, unsigned h) {
+        if (h <= 1) return;
+        unsigned top = h / 2, bottom = h - top;
+        splits[depth + top] = {(std::size_t{1} << top) - 1, (std::size_t{1} << bottom) - 1, depth};
+        splitTables(depth, top);
+        splitTables(depth + top, bottom);
+    }
+
+    // vEB position of BFS node i at depth d, given the positions of its ancestors.
+    static std::size_t vebPosition(std::size_t i, const Split& sp, const std::size_t* pos) {
+        return pos[sp.topDepth] + sp.topSize + (i & sp.topSize) * sp.bottomSize;
+    }
+
+    void layoutVeb(const T* bfs, std::size_t i, unsigned d, std::size_t* pos) {
+        if (d >= height) return;
+        pos[d] = d == 0 ? 0 : vebPosition(i, splits[d], pos);
+        storage.get()[pos[d]] = bfs[i];
+        layoutVeb(bfs, 2 * i, d + 1, pos);
+        layoutVeb(bfs, 2 * i + 1, d + 1, pos);
+    }
+
+public:
+    // sorted must be non-decreasing.
+    explicit StaticSearchTree(const std::vector<T>& sorted, Layout l = Layout::Eytzinger) : layout(l), n(sorted.size()) {
+        if (!std::is_sorted(sorted.begin(), sorted.end())) throw std::invalid_argument("StaticSearchTree: input not sorted");
+        while ((std::size_t{1} << height) - 1 < n) ++height;
+        if (n) maxKey = sorted.back();
+        std::size_t next = 0;
+        if (layout == Layout::Eytzinger) {
+            slots = n;
+            allocate(n + 1);   // index 0 unused
+            fillEytzinger(sorted.data(), n, storage.get(), 1, next);
+            return;
+        }
+        // Pad to a full tree; padding sorts after every key, so it never becomes
+        // an answer once lower_bound rejects x > maxKey.
+        slots = (std::size_t{1} << height) - 1;
+        std::vector<T> padded(sorted);
+        padded.resize(slots, std::numeric_limits<T>::max());
+        std::vector<T> bfs(slots + 1);
+        fillEytzinger(padded.data(), slots, bfs.data(), 1, next);
+        splits.assign(height + 1, Split{});
+        splitTables(0, height);
+        allocate(slots);
+        std::size_t pos[MAX_HEIGHT];
+        layoutVeb(bfs.data(), 1, 0, pos);
+    }
+
+    std::size_t size() const { return n; }
+    std::size_t memoryBytes() const { return (slots + 1) * sizeof(T); }
+
+    // Smallest key >= x, or nullptr.
+    const T* lower_bound(const T& x) const {
+        const T* a = storage.get();
+        if (layout == Layout::Eytzinger) {
+            std::size_t k = 1;
+            while (k <= n) {
+                prefetch(a, k * STRIDE);
+                k = 2 * k + (a[k] < x);
+            }
+            k >>= __builtin_ffsll(static_cast<long long>(~k));
+            return k ? a + k : nullptr;
+        }
+        if (n == 0 || maxKey < x) return nullptr;
+        std::size_t pos[MAX_HEIGHT], i = 1;
+        const T* best = nullptr;
+        const Split* sp = splits.data();
+        for (unsigned d = 0; d < height; ++d) {
+            pos[d] = d == 0 ? 0 : vebPosition(i, sp[d], pos);
+            const T* key = a + pos[d];
+            bool right = *key < x;
+            best = right ? best : key;
+            i = 2 * i + right;
+        }
+        return best;
+    }
+
+    bool contains(const T& x) const {
+        const T* p = lower_bound(x);
+        return p && !(x < *p);
+    }
+
+    // out[j] = lower_bound(xs[j]) for j < m, interleaving BATCH lookups per level.
+    void lower_bound_many(const T* xs, std::size_t m, const T** out) const {
+        const T* a = storage.get();
+        for (std::size_t start = 0; start < m; start += BATCH) {
+            std::size_t g = std::min(BATCH, m - start);
+            const T* q = xs + start;
+            if (layout == Layout::Eytzinger) {
+                std::size_t k[BATCH];
+                std::fill(k, k + g, std::size_t{1});
+                // Every level but the last is full, so only the last needs a bounds check.
+                for (unsigned d = 0; d + 1 < height; ++d)
+                    for (std::size_t j = 0; j < g; ++j) {
+                        prefetch(a, k[j] * STRIDE);
+                        k[j] = 2 * k[j] + (a[k[j]] < q[j]);
+                    }
+                for (std::size_t j = 0; j < g; ++j)
+                    if (height && k[j] <= n) k[j] = 2 * k[j] + (a[k[j]] < q[j]);
+                for (std::size_t j = 0; j < g; ++j) {
+                    std::size_t r = k[j] >> __builtin_ffsll(static_cast<long long>(~k[j]));
+                    out[start + j] = r ? a + r : nullptr;
+                }
+                continue;
+            }
+            std::size_t pos[MAX_HEIGHT][BATCH], i[BATCH];
+            const T* best[BATCH];
+            std::fill(i, i + g, std::size_t{1});
+            std::fill(best, best + g, nullptr);
+            for (unsigned d = 0; d < height; ++d) {
+                const Split sp = splits[d];
+                for (std::size_t j = 0; j < g; ++j) {
+                    pos[d][j] = d == 0 ? 0 : pos[sp.topDepth][j] + sp.topSize + (i[j] & sp.topSize) * sp.bottomSize;
+                    const T* key = a + pos[d][j];
+                    bool right = *key < q[j];
+                    best[j] = right ? best[j] : key;
+                    i[j] = 2 * i[j] + right;
+                }
+            }
+            for (std::size_t j = 0; j < g; ++j) out[start + j] = n && !(maxKey < q[j]) ? best[j] : nullptr;
+        }
+    }
+};
+
+// The original BST, with an in-order visitor so a StaticSearchTree can be
+// built from it.
+struct TNode {
+    int key;
+    std::unique_ptr<TNode> left, right;
+    explicit TNode(int k) : key(k) {}
+};
+
+class BST {
+    std::unique_ptr<TNode> root;
+    void insertRec(std::unique_ptr<TNode>& node, int k) {
+        if (!node) { node = std::make_unique<TNode>(k); return; }
+        if (k < node->key) insertRec(node->left, k); else if (k > node->key) insertRec(node->right, k);
+    }
+    bool searchRec(TNode* node, int k) const {
+        if (!node) return false;
+        if (node->key == k) return true;
+        return k < node->key ? searchRec(node->left.get(), k) : searchRec(node->right.get(), k);
+    }
+public:
+    void insert(int k) { insertRec(root, k); }
+    bool contains(int k) const { return searchRec(root.get(), k); }
+    // Calls fn(key) in ascending order, with an explicit stack.
+    template<class F>
+    void inorderVisit(F&& fn) const {
+        std::vector<const TNode*> stack;
+        const TNode* node = root.get();
+        while (node || !stack.empty()) {
+            for (; node; node = node->left.get()) stack.push_back(node);
+            node = stack.back();
+            stack.pop_back();
+            fn(node->key);
+            node = node->right.get();
+        }
+    }
+};
+
+StaticSearchTree<int> fromBst(const BST& bst, StaticSearchTree<int>::Layout layout) {
+    std::vector<int> keys;
+    bst.inorderVisit([&](int k) { keys.push_back(k); });
+    return StaticSearchTree<int>(keys, layout);
+}
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    using Layout = StaticSearchTree<int>::Layout;
+    std::cout << "=== Static search tree ===\n";
+    BST bst;
+    for (int k : {50, 30, 70, 20, 40, 60, 80}) bst.insert(k);
+    for (Layout l : {Layout::Eytzinger, Layout::VanEmdeBoas}) {
+        StaticSearchTree<int> t = fromBst(bst, l);
+        const int* lb = t.lower_bound(45);
+        std::cout << (l == Layout::Eytzinger ? "Eytzinger" : "vEB") << ": lower_bound(45) = " << (lb ? *lb : -1)
+                  << ", contains 60? " << t.contains(60) << ", lower_bound(81) is end? " << (t.lower_bound(81) == nullptr) << '\n';
+    }
+
+    // Usage: ./StaticSearchTree [maxLog2Size] [queries]
+    unsigned maxLog = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 24;
+    std::size_t numQueries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+
+    std::cout << "\nns per lookup (int keys; ~8K fit in L1, ~256K in L2, a few M in L3)\n"
+              << std::fixed << std::setprecision(1)
+              << "      keys    BST  std::lower_bound  Eytzinger  Eytz.batch     vEB  vEB.batch\n";
+    std::uint64_t s = 0x2545F4914F6CDD1DULL;
+    auto next = [&s] { s ^= s >> 12; s ^= s << 25; s ^= s >> 27; return s * 2685821657736338717ULL; };
+    for (unsigned lg = 12; lg <= maxLog; lg += 4) {
+        std::size_t n = std::size_t{1} << lg;
+        std::vector<int> sorted(n);
+        for (std::size_t i = 0; i < n; ++i) sorted[i] = static_cast<int>(2 * i);   // odd probes miss
+        std::vector<int> queries(numQueries);
+        for (auto& q : queries) q = static_cast<int>(next() % (2 * n + 2));
+
+        // Shuffled inserts keep the pointer BST at O(log n) expected depth.
+        std::vector<int> order(sorted);
+        for (std::size_t i = n; i > 1; --i) std::swap(order[i - 1], order[next() % i]);
+        auto tree = std::make_unique<BST>();
+        for (int k : order) tree->insert(k);
+        StaticSearchTree<int> eytz = fromBst(*tree, Layout::Eytzinger);
+        StaticSearchTree<int> veb(sorted, Layout::VanEmdeBoas);
+
+        std::size_t hits[6] = {};
+        std::vector<const int*> out(queries.size());
+        double ms[6];
+        ms[0] = timeMs([&] { for (int q : queries) hits[0] += tree->contains(q); });
+        ms[1] = timeMs([&] { for (int q : queries) { auto it = std::lower_bound(sorted.begin(), sorted.end(), q); hits[1] += it != sorted.end() && *it == q; } });
+        ms[2] = timeMs([&] { for (int q : queries) hits[2] += eytz.contains(q); });
+        ms[3] = timeMs([&] { eytz.lower_bound_many(queries.data(), queries.size(), out.data()); });
+        for (std::size_t i = 0; i < queries.size(); ++i) hits[3] += out[i] && *out[i] == queries[i];
+        ms[4] = timeMs([&] { for (int q : queries) hits[4] += veb.contains(q); });
+        ms[5] = timeMs([&] { veb.lower_bound_many(queries.data(), queries.size(), out.data()); });
+        for (std::size_t i = 0; i < queries.size(); ++i) hits[5] += out[i] && *out[i] == queries[i];
+        for (std::size_t h : hits)
+            if (h != hits[0]) { std::cerr << "result mismatch at n = " << n << '\n'; return 1; }
+
+        double perQuery = 1e6 / static_cast<double>(queries.size());
+        std::cout << std::setw(10) << n << std::setw(7) << ms[0] * perQuery << std::setw(18) << ms[1] * perQuery
+                  << std::setw(11) << ms[2] * perQuery << std::setw(12) << ms[3] * perQuery << std::setw(8)
+                  << ms[4] * perQuery << std::setw(11) << ms[5] * perQuery << '\n';
+    }
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 StaticSearchTree.cpp -o StaticSearchTree */
@@ -0,0 +1,247 @@
+/**
+ * @file CsrGraph.cpp
+ * @brief Compressed sparse row (CSR) graph with a parallel edge-list builder.
+ * @date 2026-10-17
+ *
+ * GraphImplementation.cpp stores std::vector<std::vector<int>>: one heap
+ * allocation per vertex and neighbour lists scattered across the heap. CSR
+ * packs the whole graph into two flat arrays:
+ *
+ *   offsets[u] .. offsets[u + 1]   index range of u's neighbours
+ *   targets[offsets[u] + i]        i-th neighbour of u
+ *
+ * plus an optional weights array parallel to targets. Vertex IDs are a template
+ * parameter (std::uint32_t or std::uint64_t); offsets are always 64-bit so a
+ * graph may have more than 4 billion edges.
+ *
+ * The builder runs in three parallel passes over the edge list:
+ * 1. count degrees (atomic increments),
+ * 2. exclusive prefix sum of the degrees into offsets,
+ * 3. scatter every edge into its slot through a per-vertex atomic cursor,
+ * and finally sorts each neighbour list so the result is deterministic.
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+// Splits [begin, end) into one contiguous chunk per thread; runs serially
+// when there are fewer than minItems indices.
+template<class F>
+void parallelFor(std::size_t begin, std::size_t end, unsigned threads, F&& fn, std::size_t minItems = 4096) {
+    if (threads <= 1 || end - begin < minItems) { for (std::size_t i = begin; i < end; ++i) fn(i); return; }
+    std::vector<std::thread> pool;
+    std::size_t chunk = (end - begin + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        std::size_t lo = begin + t * chunk, hi = std::min(end, lo + chunk);
+        if (lo >= hi) break;
+        pool.emplace_back([lo, hi, &fn] { for (std::size_t i = lo; i < hi; ++i) fn(i); });
+    }
+    for (auto& th : pool) th.join();
+}
+
+template<class V = std::uint32_t>
+class CsrGraph {
+    std::vector<std::uint64_t> offsets;
+    std::vector<V> targets;
+    std::vector<float> weights;   // empty for unweighted graphs
+
+public:
+    using Edge = std::pair<V, V>;
+
+    // Lightweight view over one neighbour list.
+    struct Range {
+        const V* first;
+        const V* last;
+        const V* begin() const { return first; }
+        const V* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    };
+
+    // Builds the graph from an edge list. If symmetrize is set, every edge is
+    // stored in both directions (like Graph::addEdge). edgeWeights, when given,
+    // must have one entry per edge.
+    static CsrGraph build(V numVertices, const std::vector<Edge>& edges, bool symmetrize,
+                          unsigned threads = std::thread::hardware_concurrency(),
+                          const std::vector<float>* edgeWeights = nullptr) {
+        threads = std::max(1u, threads);
+        const std::size_t n = numVertices;
+        CsrGraph g;
+
+        // Pass 1: degrees.
+        std::unique_ptr<std::atomic<std::uint64_t>[]> cursor(new std::atomic<std::uint64_t>[n + 1]);
+        parallelFor(0, n + 1, threads, [&](std::size_t i) { cursor[i].store(0, std::memory_order_relaxed); });
+        parallelFor(0, edges.size(), threads, [&](std::size_t e) {
+            cursor[edges[e].first].fetch_add(1, std::memory_order_relaxed);
+            if (symmetrize) cursor[edges[e].second].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        // Pass 2: blocked exclusive prefix sum (per-block sums, then a sequential
+        // scan over the block totals, then per-block fix-up).
+        g.offsets.resize(n + 1);
+        std::size_t blocks = threads * 4, blockSize = (n + blocks) / blocks + 1;
+        std::vector<std::uint64_t> blockSum(blocks + 1, 0);
+        // Each block index is a whole chunk of vertices, so parallelize per block
+        // unless the graph itself is small.
+        const std::size_t blockMin = n < 4096 ? blocks + 1 : 1;
+        parallelFor(0, blocks, threads, [&](std::size_t b) {
+            std::uint64_t s = 0;
+            for (std::size_t i = b * blockSize; i < std::min(n, (b + 1) * blockSize); ++i) s += cursor[i].load(std::memory_order_relaxed);
+            blockSum[b + 1] = s;
+        }, blockMin);
+        std::partial_sum(blockSum.begin(), blockSum.end(), blockSum.begin());
+        parallelFor(0, blocks, threads, [&](std::size_t b) {
+            std::uint64_t s = blockSum[b];
+            for (std::size_t i = b * blockSize; i < std::min(n, (b + 1) * blockSize); ++i) {
+                std::uint64_t d = cursor[i].load(std::memory_order_relaxed);
+                g.offsets[i] = s;
+                cursor[i].store(s, std::memory_order_relaxed);
+                s += d;
+            }
+        }, blockMin);
+        g.offsets[n] = blockSum[blocks];
+
+        // Pass 3: scatter.
+        g.targets.resize(g.offsets[n]);
+        if (edgeWeights) g.weights.resize(g.offsets[n]);
+        parallelFor(0, edges.size(), threads, [&](std::size_t e) {
+            V u = edges[e].first, v = edges[e].second;
+            std::uint64_t pos = cursor[u].fetch_add(1, std::memory_order_relaxed);
+            g.targets[pos] = v;
+            if (edgeWeights) g.weights[pos] = (*edgeWeights)[e];
+            if (symmetrize) {
+                pos = cursor[v].fetch_add(1, std::memory_order_relaxed);
+                g.targets[pos] = u;
+                if (edgeWeights) g.weights[pos] = (*edgeWeights)[e];
+            }
+        });
+
+        // Sort neighbour lists (keeping weights aligned) for deterministic output.
+        parallelFor(0, n, threads, [&](std::size_t u) {
+            V* first = g.targets.data() + g.offsets[u];
+            V* last = g.targets.data() + g.offsets[u + 1];
+            if (!edgeWeights) { std::sort(first, last); return; }
+            std::vector<std::pair<V, float>> tmp;
+            tmp.reserve(static_cast<std::size_t>(last - first));
+            for (std::uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) tmp.emplace_back(g.targets[i], g.weights[i]);
+            std::sort(tmp.begin(), tmp.end());
+            for (std::size_t i = 0; i < tmp.size(); ++i) {
+                g.targets[g.offsets[u] + i] = tmp[i].first;
+                g.weights[g.offsets[u] + i] = tmp[i].second;
+            }
+        });
+        return g;
+    }
+
+    V numVertices() const { return static_cast<V>(offsets.empty() ? 0 : offsets.size() - 1); }
+    std::uint64_t numEdges() const { return targets.size(); }
+    bool weighted() const { return !weights.empty(); }
+    std::uint64_t degree(V u) const { return offsets[u + 1] - offsets[u]; }
+    Range neighbors(V u) const { return {targets.data() + offsets[u], targets.data() + offsets[u + 1]}; }
+    const float* edgeWeights(V u) const { return weights.empty() ? nullptr : weights.data() + offsets[u]; }
+    std::size_t memoryBytes() const {
+        return offsets.size() * sizeof(std::uint64_t) + targets.size() * sizeof(V) + weights.size() * sizeof(float);
+    }
+
+    // Hop distances from src (UNREACHED for unreachable vertices). The frontier
+    // is a flat array instead of std::queue, so the whole traversal is two scans.
+    static constexpr V UNREACHED = static_cast<V>(-1);
+    std::vector<V> bfs(V src) const {
+        std::vector<V> dist(numVertices(), UNREACHED);
+        std::vector<V> frontier{src}, next;
+        dist[src] = 0;
+        for (V level = 1; !frontier.empty(); ++level) {
+            next.clear();
+            for (V u : frontier)
+                for (V v : neighbors(u))
+                    if (dist[v] == UNREACHED) { dist[v] = level; next.push_back(v); }
+            frontier.swap(next);
+        }
+        return dist;
+    }
+};
+
+// The original vector-of-vectors design, with BFS returning distances instead
+// of printing, used as the benchmark baseline.
+class AdjListGraph {
+    std::vector<std::vector<int>> adj;
+public:
+    explicit AdjListGraph(int n) : adj(n) {}
+    void addEdge(int u, int v) { adj[u].push_back(v); adj[v].push_back(u); }
+    std::size_t memoryBytes() const {
+        std::size_t bytes = adj.capacity() * sizeof(std::vector<int>);
+        for (const auto& list : adj) bytes += list.capacity() * sizeof(int) + (list.capacity() ? 16 : 0);  // + malloc header
+        return bytes;
+    }
+    std::vector<int> bfs(int start) const {
+        std::vector<int> dist(adj.size(), -1);
+        std::queue<int> q; q.push(start); dist[start] = 0;
+        while (!q.empty()) {
+            int u = q.front(); q.pop();
+            for (int v : adj[u]) if (dist[v] < 0) { dist[v] = dist[u] + 1; q.push(v); }
+        }
+        return dist;
+    }
+};
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== CSR graph ===\n";
+    std::vector<CsrGraph<>::Edge> small{{0, 1}, {0, 2}, {1, 3}, {2, 4}, {4, 5}};
+    std::vector<float> w{1.5f, 2.0f, 0.5f, 1.0f, 3.0f};
+    auto g = CsrGraph<>::build(6, small, true, 2, &w);
+    for (std::uint32_t u = 0; u < g.numVertices(); ++u) {
+        std::cout << u << ":";
+        const float* wt = g.edgeWeights(u);
+        std::size_t i = 0;
+        for (std::uint32_t v : g.neighbors(u)) std::cout << ' ' << v << "(w=" << wt[i++] << ')';
+        std::cout << '\n';
+    }
+    auto d = g.bfs(0);
+    std::cout << "BFS distances from 0:";
+    for (auto x : d) std::cout << ' ' << x;
+    std::cout << '\n';
+
+    // Usage: ./CsrGraph [vertices] [edges] [threads]
+    std::uint32_t n = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : (1u << 20);
+    std::size_t m = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8000000;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : std::thread::hardware_concurrency();
+    std::vector<CsrGraph<>::Edge> edges(m);
+    std::uint64_t s = 1;
+    for (auto& e : edges) {
+        s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+        e = {static_cast<std::uint32_t>((s >> 11) % n), static_cast<std::uint32_t>((s >> 37) % n)};
+    }
+
+    AdjListGraph adj(static_cast<int>(n));
+    CsrGraph<> csr;
+    double adjBuild = timeMs([&] { for (auto& e : edges) adj.addEdge(static_cast<int>(e.first), static_cast<int>(e.second)); });
+    double csrBuild = timeMs([&] { csr = CsrGraph<>::build(n, edges, true, threads); });
+    std::size_t sink = 0;
+    double adjBfs = timeMs([&] { sink += adj.bfs(0).back() != 0; });
+    double csrBfs = timeMs([&] { sink += csr.bfs(0).back() != 0; });
+
+    std::cout << "n=" << n << " undirected edges=" << m << " threads=" << threads << '\n'
+              << "                 vector<vector>   CSR\n"
+              << "build (ms)       " << adjBuild << "\t\t  " << csrBuild << '\n'
+              << "memory (MB)      " << adj.memoryBytes() / 1e6 << "\t\t  " << csr.memoryBytes() / 1e6 << '\n'
+              << "BFS (ms)         " << adjBfs << "\t\t  " << csrBfs << "   (sink " << sink << ")\n";
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 CsrGraph.cpp -o CsrGraph */
@@ -0,0 +1,260 @@
+/**
+ * @file DirectionOptimizingBfs.cpp
+ * @brief Parallel direction-optimizing BFS (Beamer et al.) over a CSR graph.
+ * @date 2026-10-17
+ *
+ * Graph::bfs in GraphImplementation.cpp walks a std::queue and prints each
+ * vertex. This version returns distance and parent arrays and parallelizes
+ * every level with std::thread, choosing the cheaper direction per level:
+ *
+ * - Top-down: every frontier vertex scans its neighbours and claims unvisited
+ *   ones with an atomic fetch_or on the visited bitmap.
+ * - Bottom-up: every unvisited vertex scans its neighbours until it finds one
+ *   in the frontier bitmap. On power-law graphs the middle levels touch most
+ *   vertices, and stopping at the first parent skips most edge checks.
+ *
+ * Heuristic: switch to bottom-up when the frontier's outgoing edges exceed
+ * 1/ALPHA of the edges left to explore, and back to top-down once the
+ * frontier holds fewer than n/BETA vertices and is shrinking.
+ *
+ * The benchmark generates an R-MAT (Kronecker) graph, runs BFS from several
+ * roots and reports GTEPS (billions of traversed edges per second).
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+
+using Vertex = std::uint32_t;
+constexpr Vertex NO_VERTEX = static_cast<Vertex>(-1);
+
+// Splits [begin, end) into one contiguous chunk per thread; fn(t, lo, hi).
+template<class F>
+void parallelChunks(std::size_t begin, std::size_t end, unsigned threads, F&& fn) {
+    if (threads <= 1 || end - begin < 1024) { fn(0u, begin, end); return; }
+    std::vector<std::thread> pool;
+    std::size_t chunk = (end - begin + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        std::size_t lo = begin + t * chunk, hi = std::min(end, lo + chunk);
+        if (lo >= hi) break;
+        pool.emplace_back([t, lo, hi, &fn] { fn(t, lo, hi); });
+    }
+    for (auto& th : pool) th.join();
+}
+
+// Minimal undirected CSR graph (see CsrGraph.cpp for the full builder).
+struct Csr {
+    std::vector<std::uint64_t> offsets;
+    std::vector<Vertex> targets;
+
+    static Csr fromEdges(Vertex n, const std::vector<std::pair<Vertex, Vertex>>& edges) {
+        Csr g;
+        g.offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+        for (auto& e : edges) { ++g.offsets[e.first + 1]; ++g.offsets[e.second + 1]; }
+        for (std::size_t i = 0; i < n; ++i) g.offsets[i + 1] += g.offsets[i];
+        g.targets.resize(g.offsets[n]);
+        std::vector<std::uint64_t> cursor(g.offsets.begin(), g.offsets.end() - 1);
+        for (auto& e : edges) { g.targets[cursor[e.first]++] = e.second; g.targets[cursor[e.second]++] = e.first; }
+        return g;
+    }
+    Vertex numVertices() const { return static_cast<Vertex>(offsets.size() - 1); }
+    std::uint64_t degree(Vertex u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+class Bitmap {
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+    std::size_t count;
+public:
+    explicit Bitmap(std::size_t bits) : words(new std::atomic<std::uint64_t>[(bits + 63) / 64]), count((bits + 63) / 64) { clear(); }
+    void clear() { for (std::size_t i = 0; i < count; ++i) words[i].store(0, std::memory_order_relaxed); }
+    bool test(std::size_t i) const { return words[i >> 6].load(std::memory_order_relaxed) >> (i & 63) & 1; }
+    // Returns true if this call changed the bit from 0 to 1.
+    bool trySet(std::size_t i) {
+        std::uint64_t bit = std::uint64_t{1} << (i & 63);
+        return !(words[i >> 6].fetch_or(bit, std::memory_order_relaxed) & bit);
+    }
+    void swap(Bitmap& other) { words.swap(other.words); std::swap(count, other.count); }
+};
+
+struct BfsResult {
+    std::vector<std::int32_t> dist;   // -1 when unreachable
+    std::vector<Vertex> parent;       // NO_VERTEX when unreachable, root is its own parent
+    int topDownLevels = 0, bottomUpLevels = 0;
+};
+
+BfsResult parallelBfs(const Csr& g, Vertex root, unsigned threads, bool directionOptimizing = true) {
+    const double ALPHA = 14.0, BETA = 24.0;
+    const Vertex n = g.numVertices();
+    BfsResult r;
+    r.dist.assign(n, -1);
+    r.parent.assign(n, NO_VERTEX);
+    Bitmap visited(n), front(n), next(n);
+
+    std::vector<Vertex> queue{root};
+    visited.trySet(root);
+    r.dist[root] = 0;
+    r.parent[root] = root;
+    std::uint64_t edgesToCheck = g.targets.size();
+    bool bottomUp = false;
+    std::size_t frontierSize = 1;
+
+    for (std::int32_t level = 1; frontierSize > 0; ++level) {
+        // Edge counts for the heuristic: m_f (frontier) vs m_u (unexplored).
+        if (directionOptimizing && !bottomUp) {
+            std::uint64_t mf = 0;
+            for (Vertex u : queue) mf += g.degree(u);
+            edgesToCheck -= std::min(edgesToCheck, mf);
+            if (static_cast<double>(mf) > static_cast<double>(edgesToCheck) / ALPHA) {
+                bottomUp = true;
+                front.clear();
+                for (Vertex u : queue) front.trySet(u);
+            }
+        }
+
+        if (!bottomUp) {
+            ++r.topDownLevels;
+            std::vector<std::vector<Vertex>> local(std::max(1u, threads));
+            parallelChunks(0, queue.size(), threads, [&](unsigned t, std::size_t lo, std::size_t hi) {
+                std::vector<Vertex>& out = local[t];
+                for (std::size_t i = lo; i < hi; ++i) {
+                    Vertex u = queue[i];
+                    for (std::uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                        Vertex v = g.targets[e];
+                        if (!visited.test(v) && visited.trySet(v)) {
+                            r.parent[v] = u;
+                            r.dist[v] = level;
+                            out.push_back(v);
+                        }
+                    }
+                }
+            });
+            queue.clear();
+            for (auto& l : local) queue.insert(queue.end(), l.begin(), l.end());
+            frontierSize = queue.size();
+        } else {
+            ++r.bottomUpLevels;
+            next.clear();
+            std::atomic<std::size_t> found{0};
+            parallelChunks(0, n, threads, [&](unsigned, std::size_t lo, std::size_t hi) {
+                std::size_t mine = 0;
+                for (std::size_t v = lo; v < hi; ++v) {
+                    if (visited.test(v)) continue;
+                    for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                        Vertex u = g.targets[e];
+                        if (front.test(u)) {
+                            // Each thread only tests visited bits of its own
+                            // vertices, so marking v here cannot race.
+                            r.parent[v] = u;
+                            r.dist[v] = level;
+                            visited.trySet(v);
+                            next.trySet(v);
+                            ++mine;
+                            break;
+                        }
+                    }
+                }
+                found += mine;
+            });
+            std::size_t previous = frontierSize;
+            frontierSize = found.load();
+            front.swap(next);
+            if (frontierSize < previous && static_cast<double>(frontierSize) < static_cast<double>(n) / BETA) {
+                bottomUp = false;
+                queue.clear();
+                for (Vertex v = 0; v < n; ++v) if (r.dist[v] == level) queue.push_back(v);
+            }
+        }
+    }
+    return r;
+}
+
+// R-MAT generator (Graph500 parameters a=0.57, b=c=0.19) with 2^scale vertices.
+std::vector<std::pair<Vertex, Vertex>> rmatEdges(int scale, int edgeFactor, std::uint64_t seed) {
+    std::size_t m = (std::size_t{1} << scale) * static_cast<std::size_t>(edgeFactor);
+    std::vector<std::pair<Vertex, Vertex>> edges(m);
+    auto next = [&seed] {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        return static_cast<double>(seed >> 11) / 9007199254740992.0;
+    };
+    for (auto& e : edges) {
+        Vertex u = 0, v = 0;
+        for (int bit = 0; bit < scale; ++bit) {
+            double p = next();
+            if (p < 0.57) {}
+            else if (p < 0.76) v |= Vertex{1} << bit;
+            else if (p < 0.95) u |= Vertex{1} << bit;
+            else { u |= Vertex{1} << bit; v |= Vertex{1} << bit; }
+        }
+        e = {u, v};
+    }
+    // Scramble IDs so high-degree vertices are not clustered at low indices.
+    std::vector<Vertex> perm(std::size_t{1} << scale);
+    for (Vertex i = 0; i < perm.size(); ++i) perm[i] = i;
+    for (std::size_t i = perm.size() - 1; i > 0; --i) std::swap(perm[i], perm[static_cast<std::size_t>(next() * static_cast<double>(i + 1))]);
+    for (auto& e : edges) e = {perm[e.first], perm[e.second]};
+    return edges;
+}
+
+static std::vector<std::int32_t> sequentialBfs(const Csr& g, Vertex root) {
+    std::vector<std::int32_t> dist(g.numVertices(), -1);
+    std::queue<Vertex> q; q.push(root); dist[root] = 0;
+    while (!q.empty()) {
+        Vertex u = q.front(); q.pop();
+        for (std::uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e)
+            if (dist[g.targets[e]] < 0) { dist[g.targets[e]] = dist[u] + 1; q.push(g.targets[e]); }
+    }
+    return dist;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Direction-optimizing parallel BFS ===\n";
+    Csr tiny = Csr::fromEdges(6, {{0, 1}, {0, 2}, {1, 3}, {2, 4}, {4, 5}});
+    BfsResult t = parallelBfs(tiny, 0, 2);
+    for (Vertex v = 0; v < 6; ++v) std::cout << v << ": dist=" << t.dist[v] << " parent=" << t.parent[v] << '\n';
+
+    // Usage: ./DirectionOptimizingBfs [scale] [edgeFactor] [maxThreads]
+    int scale = argc > 1 ? std::atoi(argv[1]) : 18;
+    int edgeFactor = argc > 2 ? std::atoi(argv[2]) : 16;
+    unsigned maxThreads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : std::max(1u, std::thread::hardware_concurrency());
+    Csr g = Csr::fromEdges(Vertex{1} << scale, rmatEdges(scale, edgeFactor, 12345));
+    std::cout << "R-MAT scale " << scale << ": " << g.numVertices() << " vertices, " << g.targets.size() / 2 << " edges\n";
+
+    // Roots with at least one edge, fixed seed for repeatability.
+    std::vector<Vertex> roots;
+    for (std::uint64_t s = 7; roots.size() < 8; s = s * 6364136223846793005ULL + 1) {
+        Vertex v = static_cast<Vertex>((s >> 33) % g.numVertices());
+        if (g.degree(v) > 0) roots.push_back(v);
+    }
+    if (sequentialBfs(g, roots[0]) != parallelBfs(g, roots[0], maxThreads).dist) { std::cout << "validation FAILED\n"; return 1; }
+
+    std::cout << "threads  top-down GTEPS  direction-optimizing GTEPS  (levels TD/BU)\n";
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        double gteps[2] = {0, 0};
+        int td = 0, bu = 0;
+        for (int mode = 0; mode < 2; ++mode) {
+            double invSum = 0;   // Graph500 reports the harmonic mean
+            for (Vertex root : roots) {
+                auto t0 = std::chrono::steady_clock::now();
+                BfsResult res = parallelBfs(g, root, threads, mode == 1);
+                double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                std::uint64_t traversed = 0;
+                for (Vertex v = 0; v < g.numVertices(); ++v) if (res.dist[v] >= 0) traversed += g.degree(v);
+                invSum += sec / (static_cast<double>(traversed / 2) / 1e9);
+                if (mode == 1) { td += res.topDownLevels; bu += res.bottomUpLevels; }
+            }
+            gteps[mode] = static_cast<double>(roots.size()) / invSum;
+        }
+        std::cout << threads << "\t " << gteps[0] << "\t\t  " << gteps[1] << "\t\t\t (" << td << '/' << bu << ")\n";
+    }
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 DirectionOptimizingBfs.cpp -o DirectionOptimizingBfs */
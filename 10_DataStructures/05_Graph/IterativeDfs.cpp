@@ -0,0 +1,280 @@
+/**
+ * @file IterativeDfs.cpp
+ * @brief Allocation-free iterative DFS with a reusable workspace, plus
+ *        topological sort, cycle detection and Tarjan's SCC.
+ * @date 2026-10-17
+ *
+ * Graph::dfsUtil in GraphImplementation.cpp recurses once per vertex (a long
+ * path overflows the call stack) and every dfs()/bfs() call allocates a new
+ * std::vector<bool>. Here:
+ *
+ * - The DFS keeps an explicit stack of (vertex, next edge) frames.
+ * - TraversalWorkspace owns that stack and an epoch-stamped visited array:
+ *   a vertex is visited iff stamp[v] == epoch, so starting a new query is
+ *   just ++epoch instead of clearing n entries.
+ * - Callers receive pre-order / post-order callbacks (template parameters,
+ *   so no std::function allocation) instead of printed output.
+ *
+ * Once a workspace has been sized for a graph, queries perform no heap
+ * allocations; main() verifies this by counting calls to operator new.
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+// Counts heap allocations so the benchmark can prove queries allocate nothing.
+static std::size_t allocationCount = 0;
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Directed graph in CSR form (see CsrGraph.cpp).
+class Digraph {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> targets;
+public:
+    Digraph(std::uint32_t n, const std::vector<std::pair<std::uint32_t, std::uint32_t>>& edges) : offsets(n + 1, 0) {
+        for (auto& e : edges) ++offsets[e.first + 1];
+        for (std::uint32_t i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+        targets.resize(edges.size());
+        std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (auto& e : edges) targets[cursor[e.first]++] = e.second;
+    }
+    std::uint32_t numVertices() const { return static_cast<std::uint32_t>(offsets.size() - 1); }
+    std::uint32_t edgeBegin(std::uint32_t u) const { return offsets[u]; }
+    std::uint32_t edgeEnd(std::uint32_t u) const { return offsets[u + 1]; }
+    std::uint32_t target(std::uint32_t e) const { return targets[e]; }
+};
+
+class TraversalWorkspace {
+public:
+    struct Frame { std::uint32_t vertex, nextEdge; };
+
+    explicit TraversalWorkspace(std::uint32_t n = 0) { resize(n); }
+
+    // Grows the arrays for a larger graph; the only call that may allocate.
+    void resize(std::uint32_t n) {
+        if (n > stamp.size()) {
+            stamp.assign(n, 0); finished.assign(n, 0);
+            index.resize(n); lowlink.resize(n);
+            epoch = 0;
+        }
+        stack.reserve(n);
+        sccStack.reserve(n);
+    }
+
+    // Starts a new query: everything stamped with an older epoch is unvisited.
+    void nextEpoch() {
+        if (++epoch == 0) {   // wrapped after 2^32 queries: clear once
+            std::fill(stamp.begin(), stamp.end(), 0);
+            std::fill(finished.begin(), finished.end(), 0);
+            epoch = 1;
+        }
+        stack.clear();
+    }
+    bool visited(std::uint32_t v) const { return stamp[v] == epoch; }
+    bool done(std::uint32_t v) const { return finished[v] == epoch; }
+    void markVisited(std::uint32_t v) { stamp[v] = epoch; }
+    void markDone(std::uint32_t v) { finished[v] = epoch; }
+
+    std::vector<Frame> stack;
+    std::vector<std::uint32_t> index, lowlink, sccStack;   // Tarjan state
+
+private:
+    std::vector<std::uint32_t> stamp, finished;
+    std::uint32_t epoch = 0;
+};
+
+// Iterative DFS from root (within the current epoch). pre(v) fires when v is
+// discovered, post(v) after all its descendants are finished; a pre callback
+// returning false prunes v's subtree. backEdge(u, v) fires for edges into a
+// vertex that is still on the stack (a cycle in a directed graph).
+template<class Pre, class Post, class BackEdge>
+void dfsFrom(const Digraph& g, TraversalWorkspace& ws, std::uint32_t root, Pre&& pre, Post&& post, BackEdge&& backEdge) {
+    if (ws.visited(root)) return;
+    ws.markVisited(root);
+    if (!pre(root)) { ws.markDone(root); post(root); return; }
+    ws.stack.push_back({root, g.edgeBegin(root)});
+    while (!ws.stack.empty()) {
+        TraversalWorkspace::Frame& f = ws.stack.back();
+        if (f.nextEdge == g.edgeEnd(f.vertex)) {
+            std::uint32_t u = f.vertex;
+            ws.stack.pop_back();
+            ws.markDone(u);
+            post(u);
+            continue;
+        }
+        std::uint32_t u = f.vertex;
+        std::uint32_t v = g.target(f.nextEdge++);
+        if (!ws.visited(v)) {
+            ws.markVisited(v);
+            if (pre(v)) ws.stack.push_back({v, g.edgeBegin(v)});   // f may dangle after this
+            else { ws.markDone(v); post(v); }
+        } else if (!ws.done(v)) {
+            backEdge(u, v);
+        }
+    }
+}
+
+template<class Pre, class Post>
+void dfs(const Digraph& g, TraversalWorkspace& ws, std::uint32_t root, Pre&& pre, Post&& post) {
+    ws.nextEpoch();
+    dfsFrom(g, ws, root, pre, post, [](std::uint32_t, std::uint32_t) {});
+}
+
+// Fills order with a topological order; returns false if the graph has a cycle.
+bool topologicalSort(const Digraph& g, TraversalWorkspace& ws, std::vector<std::uint32_t>& order) {
+    ws.nextEpoch();
+    order.clear();
+    bool acyclic = true;
+    for (std::uint32_t s = 0; s < g.numVertices(); ++s)
+        dfsFrom(g, ws, s, [](std::uint32_t) { return true; },
+                [&](std::uint32_t v) { order.push_back(v); },
+                [&](std::uint32_t, std::uint32_t) { acyclic = false; });
+    std::reverse(order.begin(), order.end());
+    return acyclic;
+}
+
+bool hasCycle(const Digraph& g, TraversalWorkspace& ws) {
+    ws.nextEpoch();
+    bool cycle = false;
+    for (std::uint32_t s = 0; s < g.numVertices() && !cycle; ++s)
+        dfsFrom(g, ws, s, [&](std::uint32_t) { return !cycle; }, [](std::uint32_t) {},
+                [&](std::uint32_t, std::uint32_t) { cycle = true; });
+    return cycle;
+}
+
+// Tarjan's strongly connected components, iteratively. component[v] receives
+// the SCC id of v (ids are in reverse topological order of the condensation);
+// returns the number of components.
+std::uint32_t stronglyConnectedComponents(const Digraph& g, TraversalWorkspace& ws, std::vector<std::uint32_t>& component) {
+    const std::uint32_t n = g.numVertices();
+    ws.nextEpoch();
+    component.resize(n);
+    ws.sccStack.clear();
+    std::uint32_t counter = 0, components = 0;
+    // done(v) is reused to mean "v has been assigned to a component".
+    for (std::uint32_t s = 0; s < n; ++s) {
+        if (ws.visited(s)) continue;
+        ws.markVisited(s);
+        ws.index[s] = ws.lowlink[s] = counter++;
+        ws.sccStack.push_back(s);
+        ws.stack.push_back({s, g.edgeBegin(s)});
+        while (!ws.stack.empty()) {
+            TraversalWorkspace::Frame& f = ws.stack.back();
+            std::uint32_t u = f.vertex;
+            if (f.nextEdge < g.edgeEnd(u)) {
+                std::uint32_t v = g.target(f.nextEdge++);
+                if (!ws.visited(v)) {
+                    ws.markVisited(v);
+                    ws.index[v] = ws.lowlink[v] = counter++;
+                    ws.sccStack.push_back(v);
+                    ws.stack.push_back({v, g.edgeBegin(v)});
+                } else if (!ws.done(v)) {
+                    ws.lowlink[u] = std::min(ws.lowlink[u], ws.index[v]);
+                }
+                continue;
+            }
+            ws.stack.pop_back();
+            if (!ws.stack.empty()) {
+                std::uint32_t parent = ws.stack.back().vertex;
+                ws.lowlink[parent] = std::min(ws.lowlink[parent], ws.lowlink[u]);
+            }
+            if (ws.lowlink[u] == ws.index[u]) {
+                std::uint32_t w;
+                do {
+                    w = ws.sccStack.back();
+                    ws.sccStack.pop_back();
+                    ws.markDone(w);
+                    component[w] = components;
+                } while (w != u);
+                ++components;
+            }
+        }
+    }
+    return components;
+}
+
+// The original recursive design, allocating its visited vector per call.
+static void recursiveDfs(const Digraph& g, std::uint32_t u, std::vector<bool>& vis, std::size_t& count) {
+    vis[u] = true; ++count;
+    for (std::uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); ++e)
+        if (!vis[g.target(e)]) recursiveDfs(g, g.target(e), vis, count);
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Iterative DFS with reusable workspace ===\n";
+    // 0 -> 1 -> 3, 0 -> 2 -> 3 -> 4, plus a cycle 5 -> 6 -> 7 -> 5
+    Digraph g(8, {{0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}, {5, 6}, {6, 7}, {7, 5}, {4, 5}});
+    TraversalWorkspace ws(g.numVertices());
+    std::cout << "DFS pre-order from 0:";
+    dfs(g, ws, 0, [](std::uint32_t v) { std::cout << ' ' << v; return true; }, [](std::uint32_t) {});
+    std::cout << "\nHas cycle? " << hasCycle(g, ws) << '\n';
+    std::vector<std::uint32_t> comp;
+    std::uint32_t k = stronglyConnectedComponents(g, ws, comp);
+    std::cout << "SCCs: " << k << " (component of 5,6,7 = " << comp[5] << ',' << comp[6] << ',' << comp[7] << ")\n";
+    Digraph dag(5, {{0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}});
+    std::vector<std::uint32_t> order;
+    bool ok = topologicalSort(dag, ws, order);
+    std::cout << "Topological order (acyclic=" << ok << "):";
+    for (auto v : order) std::cout << ' ' << v;
+    std::cout << '\n';
+
+    // A 2M-vertex path: the recursive version would overflow the call stack.
+    const std::uint32_t pathLen = 2000000;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pathEdges;
+    for (std::uint32_t i = 0; i + 1 < pathLen; ++i) pathEdges.emplace_back(i, i + 1);
+    Digraph path(pathLen, pathEdges);
+    TraversalWorkspace pathWs(pathLen);
+    std::size_t seen = 0;
+    dfs(path, pathWs, 0, [&](std::uint32_t) { ++seen; return true; }, [](std::uint32_t) {});
+    std::cout << "Visited " << seen << " vertices along a " << pathLen << "-vertex path without recursion\n";
+
+    // Many small traversals on one graph: 50k components of 20 vertices each.
+    std::size_t queries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::uint32_t comps = 50000, size = 20, n = comps * size;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+    for (std::uint32_t c = 0; c < comps; ++c)
+        for (std::uint32_t i = 0; i < size; ++i) {
+            edges.emplace_back(c * size + i, c * size + (i + 1) % size);
+            edges.emplace_back(c * size + i, c * size + (i * 7 + 3) % size);
+        }
+    Digraph many(n, edges);
+    TraversalWorkspace manyWs(n);
+    std::size_t visitedTotal = 0;
+    std::size_t allocsBefore = allocationCount;
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t q = 0; q < queries; ++q)
+        dfs(many, manyWs, static_cast<std::uint32_t>((q * 2654435761u) % n),
+            [&](std::uint32_t) { ++visitedTotal; return true; }, [](std::uint32_t) {});
+    double iterSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::size_t iterAllocs = allocationCount - allocsBefore;
+
+    std::size_t recursiveTotal = 0;
+    allocsBefore = allocationCount;
+    t0 = std::chrono::steady_clock::now();
+    for (std::size_t q = 0; q < queries; ++q) {
+        std::vector<bool> vis(n);
+        recursiveDfs(many, static_cast<std::uint32_t>((q * 2654435761u) % n), vis, recursiveTotal);
+    }
+    double recSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::size_t recAllocs = allocationCount - allocsBefore;
+
+    std::cout << queries << " queries on a " << n << "-vertex graph\n"
+              << "  workspace DFS: " << queries / iterSec / 1e6 << " M queries/s, " << iterAllocs << " allocations\n"
+              << "  recursive DFS: " << queries / recSec / 1e6 << " M queries/s, " << recAllocs << " allocations"
+              << " (visited " << visitedTotal << " / " << recursiveTotal << ")\n";
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 IterativeDfs.cpp -o IterativeDfs */
@@ -0,0 +1,329 @@
+/**
+ * @file MappedGraphFile.cpp
+ * @brief Versioned binary CSR graph file with zero-copy mmap loading.
+ * @date 2026-10-17
+ *
+ * Rebuilding a graph through addEdge() on every start parses and allocates
+ * the whole edge list. Instead, the CSR arrays (see CsrGraph.cpp) are written
+ * once in their in-memory layout and later mapped read-only with mmap: opening
+ * costs a header check, and pages are faulted in only when a traversal
+ * touches them.
+ *
+ * File layout (little-endian, every section 64-byte aligned):
+ *
+ *   Header (64 bytes)  magic "CSRGRAF\0", version, flags, endian marker,
+ *                      vertex/edge counts, section offsets, checksums
+ *   offsets            (numVertices + 1) x uint64
+ *   targets            numEdges x uint32 or uint64 (FLAG_64BIT_IDS)
+ *   weights            numEdges x float (only with FLAG_WEIGHTED)
+ *
+ * The header carries its own checksum, always verified on open, and the
+ * section bounds it declares are checked against the file size. Verify::Header
+ * trusts the section contents: a corrupt offsets or targets array can still
+ * send neighbors() outside the mapping, so use it only for files you wrote.
+ * Verify::Full reads the whole file: it checks the section checksum, that
+ * offsets start at 0, never decrease and end at numEdges, and that every
+ * target is a valid vertex ID. After that, no accessor can leave the mapping.
+ *
+ * POSIX only (open/mmap/munmap).
+ */
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <queue>
+#include <string>
+#include <stdexcept>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace graphfile {
+
+constexpr char MAGIC[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'F', '\0'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t ENDIAN_MARKER = 0x01020304;
+constexpr std::uint32_t FLAG_WEIGHTED = 1u << 0;
+constexpr std::uint32_t FLAG_64BIT_IDS = 1u << 1;
+constexpr std::uint64_t ALIGNMENT = 64;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t endianMarker;
+    std::uint32_t headerChecksum;   // over the whole header with this field zeroed
+    std::uint64_t numVertices;
+    std::uint64_t numEdges;
+    std::uint64_t targetsOffset;    // offsets section always starts at sizeof(Header)
+    std::uint64_t weightsOffset;    // 0 when unweighted
+    std::uint64_t sectionChecksum;  // over offsets, targets and weights
+};
+static_assert(sizeof(Header) == 64, "header must stay 64 bytes");
+
+// Word-at-a-time multiply/rotate hash; much faster than a byte-wise FNV.
+inline std::uint64_t checksum(const void* data, std::size_t bytes, std::uint64_t h = 0x9e3779b97f4a7c15ULL) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        std::uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdULL;
+        h = (h << 31) | (h >> 33);
+    }
+    for (; i < bytes; ++i) h = (h ^ p[i]) * 0x100000001b3ULL;
+    return h ^ (h >> 29);
+}
+
+inline std::uint32_t headerChecksum(Header h) {
+    h.headerChecksum = 0;
+    return static_cast<std::uint32_t>(checksum(&h, sizeof h));
+}
+
+inline std::uint64_t alignUp(std::uint64_t x) { return (x + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+// Writes a CSR graph. V selects 32- or 64-bit vertex IDs; weights may be empty.
+template<class V>
+void write(const std::string& path, const std::vector<std::uint64_t>& offsets,
+           const std::vector<V>& targets, const std::vector<float>& weights = {}) {
+    static_assert(std::is_same<V, std::uint32_t>::value || std::is_same<V, std::uint64_t>::value, "32- or 64-bit IDs");
+    if (offsets.empty() || offsets.back() != targets.size()) throw std::invalid_argument("graphfile::write: offsets do not match targets");
+    if (!weights.empty() && weights.size() != targets.size()) throw std::invalid_argument("graphfile::write: one weight per edge required");
+
+    Header h{};
+    std::memcpy(h.magic, MAGIC, sizeof MAGIC);
+    h.version = VERSION;
+    h.flags = (weights.empty() ? 0 : FLAG_WEIGHTED) | (sizeof(V) == 8 ? FLAG_64BIT_IDS : 0);
+    h.endianMarker = ENDIAN_MARKER;
+    h.numVertices = offsets.size() - 1;
+    h.numEdges = targets.size();
+    h.targetsOffset = alignUp(sizeof(Header) + offsets.size() * sizeof(std::uint64_t));
+    std::uint64_t end = h.targetsOffset + targets.size() * sizeof(V);
+    h.weightsOffset = weights.empty() ? 0 : alignUp(end);
+    std::uint64_t sum = checksum(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+    sum = checksum(targets.data(), targets.size() * sizeof(V), sum);
+    if (!weights.empty()) sum = checksum(weights.data(), weights.size() * sizeof(float), sum);
+    h.sectionChecksum = sum;
+    h.headerChecksum = headerChecksum(h);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("graphfile::write: cannot create " + path);
+    auto pad = [&out](std::uint64_t to) {
+        static const char zeros[ALIGNMENT] = {};
+        std::uint64_t pos = static_cast<std::uint64_t>(out.tellp());
+        out.write(zeros, static_cast<std::streamsize>(to - pos));
+    };
+    out.write(reinterpret_cast<const char*>(&h), sizeof h);
+    out.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(std::uint64_t)));
+    pad(h.targetsOffset);
+    out.write(reinterpret_cast<const char*>(targets.data()), static_cast<std::streamsize>(targets.size() * sizeof(V)));
+    if (!weights.empty()) {
+        pad(h.weightsOffset);
+        out.write(reinterpret_cast<const char*>(weights.data()), static_cast<std::streamsize>(weights.size() * sizeof(float)));
+    }
+    if (!out) throw std::runtime_error("graphfile::write: I/O error on " + path);
+}
+
+} // namespace graphfile
+
+// Read-only graph view backed directly by the mapped file.
+template<class V = std::uint32_t>
+class MappedGraph {
+    void* base = MAP_FAILED;
+    std::size_t length = 0;
+    const graphfile::Header* header = nullptr;
+    const std::uint64_t* offsets = nullptr;
+    const V* targets = nullptr;
+    const float* weights = nullptr;
+
+    void unmap() {
+        if (base != MAP_FAILED) munmap(base, length);
+        base = MAP_FAILED;
+    }
+
+public:
+    // Header: header checksum and section bounds only. Full: also section
+    // contents (see the file comment).
+    enum class Verify { Header, Full };
+
+    struct Range {
+        const V* first;
+        const V* last;
+        const V* begin() const { return first; }
+        const V* end() const { return last; }
+    };
+
+    explicit MappedGraph(const std::string& path, Verify verify = Verify::Header) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("MappedGraph: cannot open " + path);
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(graphfile::Header)) {
+            ::close(fd);
+            throw std::runtime_error("MappedGraph: " + path + " is too small");
+        }
+        length = static_cast<std::size_t>(st.st_size);
+        base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);   // the mapping keeps the file alive
+        if (base == MAP_FAILED) throw std::runtime_error("MappedGraph: mmap failed for " + path);
+
+        try {
+            validate(verify);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+    ~MappedGraph() { unmap(); }
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+    MappedGraph(MappedGraph&& o) noexcept { *this = std::move(o); }
+    MappedGraph& operator=(MappedGraph&& o) noexcept {
+        if (this != &o) {
+            unmap();
+            std::swap(base, o.base); std::swap(length, o.length);
+            header = o.header; offsets = o.offsets; targets = o.targets; weights = o.weights;
+        }
+        return *this;
+    }
+
+    V numVertices() const { return static_cast<V>(header->numVertices); }
+    std::uint64_t numEdges() const { return header->numEdges; }
+    bool weighted() const { return weights != nullptr; }
+    std::uint64_t degree(V u) const { return offsets[u + 1] - offsets[u]; }
+    Range neighbors(V u) const { return {targets + offsets[u], targets + offsets[u + 1]}; }
+    const float* edgeWeights(V u) const { return weights ? weights + offsets[u] : nullptr; }
+
+private:
+    void validate(Verify verify) {
+        using namespace graphfile;
+        const char* bytes = static_cast<const char*>(base);
+        header = reinterpret_cast<const Header*>(bytes);
+        if (std::memcmp(header->magic, MAGIC, sizeof MAGIC) != 0) throw std::runtime_error("MappedGraph: not a CSR graph file");
+        if (header->endianMarker != ENDIAN_MARKER) throw std::runtime_error("MappedGraph: byte order mismatch");
+        if (header->version != VERSION) throw std::runtime_error("MappedGraph: unsupported version " + std::to_string(header->version));
+        if (header->headerChecksum != headerChecksum(*header)) throw std::runtime_error("MappedGraph: header checksum mismatch");
+        if (((header->flags & FLAG_64BIT_IDS) != 0) != (sizeof(V) == 8)) throw std::runtime_error("MappedGraph: vertex ID width mismatch");
+
+        // Bounds: every section must lie inside the file. Counts are compared
+        // against length / element size before multiplying, and offsets as
+        // offset <= length - bytes, so a corrupt header cannot wrap around.
+        const bool weighted = (header->flags & FLAG_WEIGHTED) != 0;
+        if (header->numVertices >= length / sizeof(std::uint64_t) || header->numEdges > length / sizeof(V))
+            throw std::runtime_error("MappedGraph: truncated file");
+        std::uint64_t offsetsBytes = (header->numVertices + 1) * sizeof(std::uint64_t);
+        std::uint64_t targetsBytes = header->numEdges * sizeof(V);
+        std::uint64_t weightsBytes = weighted ? header->numEdges * sizeof(float) : 0;
+        if (header->targetsOffset % ALIGNMENT != 0 || (weighted && header->weightsOffset % ALIGNMENT != 0))
+            throw std::runtime_error("MappedGraph: misaligned section");
+        if (offsetsBytes > length - sizeof(Header) || header->targetsOffset < sizeof(Header) + offsetsBytes ||
+            header->targetsOffset > length || targetsBytes > length - header->targetsOffset ||
+            (weighted && (header->weightsOffset > length || weightsBytes > length - header->weightsOffset)))
+            throw std::runtime_error("MappedGraph: truncated file");
+
+        offsets = reinterpret_cast<const std::uint64_t*>(bytes + sizeof(Header));
+        targets = reinterpret_cast<const V*>(bytes + header->targetsOffset);
+        weights = weightsBytes ? reinterpret_cast<const float*>(bytes + header->weightsOffset) : nullptr;
+
+        if (verify == Verify::Full) {
+            std::uint64_t sum = checksum(offsets, offsetsBytes);
+            sum = checksum(targets, targetsBytes, sum);
+            if (weights) sum = checksum(weights, weightsBytes, sum);
+            if (sum != header->sectionChecksum) throw std::runtime_error("MappedGraph: data checksum mismatch");
+            // The checksum is not cryptographic, so check the structure too.
+            if (offsets[0] != 0 || offsets[header->numVertices] != header->numEdges)
+                throw std::runtime_error("MappedGraph: inconsistent offsets");
+            for (std::uint64_t u = 0; u < header->numVertices; ++u)
+                if (offsets[u] > offsets[u + 1]) throw std::runtime_error("MappedGraph: inconsistent offsets");
+            for (std::uint64_t e = 0; e < header->numEdges; ++e)
+                if (targets[e] >= header->numVertices) throw std::runtime_error("MappedGraph: target out of range");
+        }
+    }
+};
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Memory-mapped CSR graph file ===\n";
+    const std::string smallPath = "small_graph.csr";
+    // Undirected path 0-1-2-3 with weights, stored as both directions.
+    graphfile::write<std::uint32_t>(smallPath, {0, 1, 3, 5, 6}, {1, 0, 2, 1, 3, 2}, {1.f, 1.f, 2.f, 2.f, 3.f, 3.f});
+    {
+        MappedGraph<> g(smallPath, MappedGraph<>::Verify::Full);
+        for (std::uint32_t u = 0; u < g.numVertices(); ++u) {
+            std::cout << u << ":";
+            const float* w = g.edgeWeights(u);
+            for (std::uint32_t v : g.neighbors(u)) std::cout << ' ' << v << "(w=" << *w++ << ')';
+            std::cout << '\n';
+        }
+    }
+    try {
+        MappedGraph<std::uint64_t> wrongWidth(smallPath);
+    } catch (const std::exception& e) {
+        std::cout << "Expected error: " << e.what() << '\n';
+    }
+    std::remove(smallPath.c_str());
+
+    // Usage: ./MappedGraphFile [vertices] [edges] [path]
+    std::uint32_t n = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : (1u << 20);
+    std::uint64_t m = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8000000;
+    std::string path = argc > 3 ? argv[3] : "bench_graph.csr";
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges(m);
+    std::uint64_t s = 1;
+    for (auto& e : edges) {
+        s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+        e = {static_cast<std::uint32_t>((s >> 11) % n), static_cast<std::uint32_t>((s >> 37) % n)};
+    }
+
+    // Baseline: what every start does today (addEdge into vector<vector<int>>).
+    std::vector<std::vector<int>> adj;
+    double rebuild = timeMs([&] {
+        adj.assign(n, {});
+        for (auto& e : edges) { adj[e.first].push_back(static_cast<int>(e.second)); adj[e.second].push_back(static_cast<int>(e.first)); }
+    });
+
+    std::vector<std::uint64_t> offsets(std::size_t{n} + 1, 0);
+    std::vector<std::uint32_t> targets;
+    for (std::uint32_t u = 0; u < n; ++u) offsets[u + 1] = offsets[u] + adj[u].size();
+    targets.reserve(offsets[n]);
+    for (auto& list : adj) targets.insert(targets.end(), list.begin(), list.end());
+    adj.clear(); adj.shrink_to_fit();
+    double writeMs = timeMs([&] { graphfile::write(path, offsets, targets); });
+
+    MappedGraph<> g(path);
+    double openMs = timeMs([&] { g = MappedGraph<>(path); });
+    double verifyMs = timeMs([&] { MappedGraph<> full(path, MappedGraph<>::Verify::Full); });
+    std::size_t reached = 0;
+    double bfsMs = timeMs([&] {
+        std::vector<bool> seen(g.numVertices());
+        std::queue<std::uint32_t> q; q.push(0); seen[0] = true;
+        while (!q.empty()) {
+            std::uint32_t u = q.front(); q.pop(); ++reached;
+            for (std::uint32_t v : g.neighbors(u)) if (!seen[v]) { seen[v] = true; q.push(v); }
+        }
+    });
+
+    std::cout << "n=" << n << " arcs=" << g.numEdges() << " file=" << path << '\n'
+              << "  rebuild via addEdge   " << rebuild << " ms\n"
+              << "  write file            " << writeMs << " ms\n"
+              << "  mmap open (header)    " << openMs << " ms\n"
+              << "  mmap open + checksum  " << verifyMs << " ms\n"
+              << "  BFS over mapping      " << bfsMs << " ms (reached " << reached << ")\n";
+    std::remove(path.c_str());
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 MappedGraphFile.cpp -o MappedGraphFile */
@@ -0,0 +1,307 @@
+/**
+ * @file ShortestPaths.cpp
+ * @brief Weighted single-source shortest paths: d-ary heap Dijkstra and
+ *        parallel delta-stepping.
+ * @date 2026-10-17
+ *
+ * GraphImplementation.cpp has no edge weights. WeightedGraph stores a CSR
+ * adjacency (see CsrGraph.cpp) with a 32-bit integer weight per edge, and
+ * shortestPaths() offers two back ends returning the same distance array.
+ * Distances are 64-bit: a simple path has fewer than 2^32 edges of weight
+ * below 2^32, so no sum can overflow.
+ *
+ * - Backend::Dijkstra: sequential, with an indexed 4-ary min-heap. Four
+ *   children share a cache line, so sift-down touches fewer lines than a
+ *   binary heap, and decrease-key keeps the heap at most n entries.
+ * - Backend::DeltaStepping: vertices are grouped into buckets of width delta
+ *   by tentative distance. All vertices of the current bucket are relaxed in
+ *   parallel (atomic compare-and-swap minimum on the distance), each thread
+ *   collects improved vertices into thread-local buckets, and the smallest
+ *   non-empty bucket becomes the next frontier. Larger delta means fewer,
+ *   more parallel rounds but more re-relaxations. A relaxation from bucket i
+ *   lands at most ceil(maxWeight / delta) buckets ahead, so the buckets are
+ *   a ring of that many + 1 entries rather than one per possible distance.
+ */
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+
+using Vertex = std::uint32_t;
+using Distance = std::uint64_t;
+constexpr Distance INF = static_cast<Distance>(-1);
+
+struct WeightedEdge { Vertex from, to; std::uint32_t weight; };
+
+class WeightedGraph {
+    std::vector<std::uint64_t> offsets;
+    std::vector<Vertex> targets;
+    std::vector<std::uint32_t> weights;
+    std::uint32_t maxW = 0;
+public:
+    WeightedGraph(Vertex n, const std::vector<WeightedEdge>& edges, bool undirected) : offsets(std::size_t{n} + 1, 0) {
+        for (auto& e : edges) { ++offsets[e.from + 1]; if (undirected) ++offsets[e.to + 1]; }
+        for (std::size_t i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+        targets.resize(offsets[n]);
+        weights.resize(offsets[n]);
+        std::vector<std::uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+        auto add = [&](Vertex u, Vertex v, std::uint32_t w) { targets[cursor[u]] = v; weights[cursor[u]++] = w; };
+        for (auto& e : edges) { add(e.from, e.to, e.weight); if (undirected) add(e.to, e.from, e.weight); }
+        for (auto& e : edges) maxW = std::max(maxW, e.weight);
+    }
+    Vertex numVertices() const { return static_cast<Vertex>(offsets.size() - 1); }
+    std::uint64_t numEdges() const { return targets.size(); }
+    std::uint64_t edgeBegin(Vertex u) const { return offsets[u]; }
+    std::uint64_t edgeEnd(Vertex u) const { return offsets[u + 1]; }
+    Vertex target(std::uint64_t e) const { return targets[e]; }
+    std::uint32_t weight(std::uint64_t e) const { return weights[e]; }
+    std::uint32_t maxWeight() const { return maxW; }
+};
+
+// Indexed D-ary min-heap over vertex IDs keyed by distance, with decrease-key.
+template<int D = 4>
+class DaryHeap {
+    std::vector<Vertex> heap;
+    std::vector<std::uint32_t> pos;   // position in heap, NOT_IN_HEAP otherwise
+    const std::vector<Distance>& key;
+    static constexpr std::uint32_t NOT_IN_HEAP = static_cast<std::uint32_t>(-1);
+
+    void siftUp(std::uint32_t i) {
+        Vertex v = heap[i];
+        while (i > 0) {
+            std::uint32_t p = (i - 1) / D;
+            if (key[heap[p]] <= key[v]) break;
+            heap[i] = heap[p]; pos[heap[i]] = i; i = p;
+        }
+        heap[i] = v; pos[v] = i;
+    }
+    void siftDown(std::uint32_t i) {
+        Vertex v = heap[i];
+        const std::uint32_t n = static_cast<std::uint32_t>(heap.size());
+        while (true) {
+            std::uint32_t first = i * D + 1;
+            if (first >= n) break;
+            std::uint32_t best = first;
+            for (std::uint32_t c = first + 1; c < std::min(first + D, n); ++c)
+                if (key[heap[c]] < key[heap[best]]) best = c;
+            if (key[heap[best]] >= key[v]) break;
+            heap[i] = heap[best]; pos[heap[i]] = i; i = best;
+        }
+        heap[i] = v; pos[v] = i;
+    }
+public:
+    DaryHeap(std::size_t n, const std::vector<Distance>& keys) : pos(n, NOT_IN_HEAP), key(keys) { heap.reserve(n); }
+    bool empty() const { return heap.empty(); }
+    // Inserts v or, if present, restores heap order after key[v] decreased.
+    void pushOrDecrease(Vertex v) {
+        if (pos[v] == NOT_IN_HEAP) { heap.push_back(v); siftUp(static_cast<std::uint32_t>(heap.size() - 1)); }
+        else siftUp(pos[v]);
+    }
+    Vertex pop() {
+        Vertex top = heap.front();
+        pos[top] = NOT_IN_HEAP;
+        heap.front() = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) siftDown(0);
+        return top;
+    }
+};
+
+std::vector<Distance> dijkstra(const WeightedGraph& g, Vertex src) {
+    std::vector<Distance> dist(g.numVertices(), INF);
+    DaryHeap<4> heap(g.numVertices(), dist);
+    dist[src] = 0;
+    heap.pushOrDecrease(src);
+    while (!heap.empty()) {
+        Vertex u = heap.pop();
+        for (std::uint64_t e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+            Vertex v = g.target(e);
+            Distance nd = dist[u] + g.weight(e);
+            if (nd < dist[v]) { dist[v] = nd; heap.pushOrDecrease(v); }
+        }
+    }
+    return dist;
+}
+
+// Reusable barrier (C++17 has no std::barrier). The last thread to arrive
+// runs onComplete before releasing the others.
+class Barrier {
+    std::mutex mtx;
+    std::condition_variable cv;
+    unsigned threads, waiting = 0;
+    std::size_t generation = 0;
+public:
+    explicit Barrier(unsigned n) : threads(n) {}
+    template<class F>
+    void arriveAndWait(F&& onComplete) {
+        std::unique_lock<std::mutex> lock(mtx);
+        std::size_t gen = generation;
+        if (++waiting == threads) {
+            onComplete();
+            waiting = 0;
+            ++generation;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return gen != generation; });
+        }
+    }
+    void arriveAndWait() { arriveAndWait([] {}); }
+};
+
+std::vector<Distance> deltaStepping(const WeightedGraph& g, Vertex src, Distance delta, unsigned threads) {
+    const Vertex n = g.numVertices();
+    std::unique_ptr<std::atomic<Distance>[]> dist(new std::atomic<Distance>[n]);
+    for (Vertex v = 0; v < n; ++v) dist[v].store(INF, std::memory_order_relaxed);
+    dist[src].store(0, std::memory_order_relaxed);
+
+    // Ring of buckets: bucket b lives in slot b % ring.
+    const std::size_t ring = static_cast<std::size_t>((g.maxWeight() + delta - 1) / delta) + 1;
+    std::vector<Vertex> frontier{src};
+    std::size_t bucket = 0;
+    std::atomic<std::size_t> nextIndex{0};
+    std::atomic<std::size_t> nextBucket{SIZE_MAX};
+    std::atomic<std::size_t> nextSize{0};
+    std::vector<std::vector<std::vector<Vertex>>> localBins(threads);
+    Barrier barrier(threads);
+
+    auto worker = [&](unsigned t) {
+        std::vector<std::vector<Vertex>>& bins = localBins[t];
+        bins.resize(ring);
+        while (true) {
+            // 1. Relax the current bucket; work is handed out in small chunks.
+            const Distance lower = static_cast<Distance>(bucket) * delta;
+            for (std::size_t i; (i = nextIndex.fetch_add(64, std::memory_order_relaxed)) < frontier.size();) {
+                for (std::size_t j = i; j < std::min(i + 64, frontier.size()); ++j) {
+                    Vertex u = frontier[j];
+                    Distance du = dist[u].load(std::memory_order_relaxed);
+                    if (du < lower) continue;   // stale entry: u settled in an earlier bucket
+                    for (std::uint64_t e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+                        Vertex v = g.target(e);
+                        Distance nd = du + g.weight(e);
+                        Distance old = dist[v].load(std::memory_order_relaxed);
+                        while (nd < old && !dist[v].compare_exchange_weak(old, nd, std::memory_order_relaxed)) {}
+                        if (nd < old) bins[static_cast<std::size_t>(nd / delta) % ring].push_back(v);
+                    }
+                }
+            }
+            barrier.arriveAndWait();
+
+            // 2. Agree on the smallest non-empty bucket.
+            for (std::size_t b = bucket; b < bucket + ring; ++b) {
+                if (bins[b % ring].empty()) continue;
+                std::size_t cur = nextBucket.load();
+                while (b < cur && !nextBucket.compare_exchange_weak(cur, b)) {}
+                break;
+            }
+            barrier.arriveAndWait([&] {
+                bucket = nextBucket.load();
+                nextBucket = SIZE_MAX;
+                nextSize = 0;
+                nextIndex = 0;
+            });
+            if (bucket == SIZE_MAX) return;
+
+            // 3. Gather every thread's copy of that bucket into the frontier.
+            std::vector<Vertex>& current = bins[bucket % ring];
+            std::size_t mine = current.size();
+            std::size_t offset = nextSize.fetch_add(mine);
+            barrier.arriveAndWait([&] { frontier.resize(nextSize.load()); });
+            if (mine) {
+                std::copy(current.begin(), current.end(), frontier.begin() + static_cast<std::ptrdiff_t>(offset));
+                current.clear();
+            }
+            barrier.arriveAndWait();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    std::vector<Distance> out(n);
+    for (Vertex v = 0; v < n; ++v) out[v] = dist[v].load(std::memory_order_relaxed);
+    return out;
+}
+
+enum class Backend { Dijkstra, DeltaStepping };
+
+std::vector<Distance> shortestPaths(const WeightedGraph& g, Vertex src, Backend backend,
+                                    Distance delta = 64, unsigned threads = std::thread::hardware_concurrency()) {
+    if (backend == Backend::Dijkstra) return dijkstra(g, src);
+    // Widen delta if needed so the bucket ring stays at most MAX_BUCKETS long.
+    constexpr Distance MAX_BUCKETS = 1 << 16;
+    delta = std::max({Distance{1}, delta, (g.maxWeight() + MAX_BUCKETS - 1) / MAX_BUCKETS});
+    return deltaStepping(g, src, delta, std::max(1u, threads));
+}
+
+static std::uint64_t nextRandom(std::uint64_t& s) {
+    s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+    return s;
+}
+
+// Road-network-like: a 2D grid (degree <= 4, large diameter) with weights 1..255.
+static WeightedGraph gridGraph(Vertex side, std::uint64_t seed) {
+    std::vector<WeightedEdge> edges;
+    for (Vertex r = 0; r < side; ++r)
+        for (Vertex c = 0; c < side; ++c) {
+            Vertex u = r * side + c;
+            if (c + 1 < side) edges.push_back({u, u + 1, static_cast<std::uint32_t>(nextRandom(seed) % 255 + 1)});
+            if (r + 1 < side) edges.push_back({u, u + side, static_cast<std::uint32_t>(nextRandom(seed) % 255 + 1)});
+        }
+    return WeightedGraph(side * side, edges, true);
+}
+
+// Uniform random graph (small diameter) with weights 1..255.
+static WeightedGraph randomGraph(Vertex n, std::size_t m, std::uint64_t seed) {
+    std::vector<WeightedEdge> edges(m);
+    for (auto& e : edges)
+        e = {static_cast<Vertex>(nextRandom(seed) % n), static_cast<Vertex>(nextRandom(seed) % n),
+             static_cast<std::uint32_t>(nextRandom(seed) % 255 + 1)};
+    return WeightedGraph(n, edges, true);
+}
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void benchmark(const char* name, const WeightedGraph& g, Distance delta, unsigned maxThreads) {
+    std::vector<Distance> ref, ds;
+    double dij = timeMs([&] { ref = shortestPaths(g, 0, Backend::Dijkstra); });
+    std::cout << name << ": " << g.numVertices() << " vertices, " << g.numEdges() << " arcs, delta=" << delta << '\n'
+              << "  Dijkstra (4-ary heap)     " << dij << " ms\n";
+    for (unsigned t = 1; t <= maxThreads; t *= 2) {
+        double ms = timeMs([&] { ds = shortestPaths(g, 0, Backend::DeltaStepping, delta, t); });
+        std::cout << "  delta-stepping " << t << " thread(s) " << ms << " ms" << (ds == ref ? "" : "  MISMATCH") << '\n';
+    }
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Weighted shortest paths ===\n";
+    WeightedGraph g(6, {{0, 1, 7}, {0, 2, 9}, {0, 5, 14}, {1, 2, 10}, {1, 3, 15}, {2, 3, 11}, {2, 5, 2}, {3, 4, 6}, {4, 5, 9}}, true);
+    auto a = shortestPaths(g, 0, Backend::Dijkstra);
+    auto b = shortestPaths(g, 0, Backend::DeltaStepping, 5, 2);
+    for (Vertex v = 0; v < 6; ++v) std::cout << "dist(0," << v << ") = " << a[v] << " / " << b[v] << '\n';
+
+    // Usage: ./ShortestPaths [gridSide] [randomVertices] [maxThreads]
+    Vertex side = argc > 1 ? static_cast<Vertex>(std::atoi(argv[1])) : 700;
+    Vertex n = argc > 2 ? static_cast<Vertex>(std::atoi(argv[2])) : 500000;
+    unsigned maxThreads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : std::max(1u, std::thread::hardware_concurrency());
+    benchmark("grid (road-like)", gridGraph(side, 42), 1024, maxThreads);
+    benchmark("uniform random", randomGraph(n, std::size_t{n} * 8, 43), 32, maxThreads);
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 ShortestPaths.cpp -o ShortestPaths */
@@ -0,0 +1,349 @@
+/**
+ * @file VertexReordering.cpp
+ * @brief Cache-aware vertex relabelling: reverse Cuthill-McKee, degree sort
+ *        and hub clustering, with before/after BFS, PageRank and triangles.
+ * @date 2026-10-17
+ *
+ * Graph::addEdge uses the caller's vertex IDs as-is. When those IDs are
+ * unrelated to the graph's structure, every neighbour visit touches a random
+ * cache line of the per-vertex arrays (distances, ranks, ...). A reordering
+ * pass computes a permutation, relabels the CSR arrays and keeps the mapping in
+ * both directions so results can be translated back:
+ *
+ * - RCM (reverse Cuthill-McKee): BFS from a low-degree vertex of each
+ *   component, visiting neighbours by increasing degree, then reversed. Gives
+ *   neighbours nearby IDs (small matrix bandwidth); best for meshes and road
+ *   networks.
+ * - Degree sort: vertices by decreasing degree, so the hot high-degree
+ *   vertices share cache lines. Suits power-law graphs but scatters everything
+ *   else.
+ * - Hub clustering: vertices with above-average degree first, each group in
+ *   its original relative order. Packs hubs like degree sort while keeping
+ *   whatever locality the input labels already had.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+using Vertex = std::uint32_t;
+using Edge = std::pair<Vertex, Vertex>;
+
+// Undirected CSR graph with sorted, duplicate-free neighbour lists.
+struct Csr {
+    std::vector<std::uint64_t> offsets;
+    std::vector<Vertex> targets;
+
+    static Csr fromEdges(Vertex n, const std::vector<Edge>& edges) {
+        Csr g;
+        g.offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+        for (auto& e : edges) if (e.first != e.second) { ++g.offsets[e.first + 1]; ++g.offsets[e.second + 1]; }
+        for (std::size_t i = 0; i < n; ++i) g.offsets[i + 1] += g.offsets[i];
+        g.targets.resize(g.offsets[n]);
+        std::vector<std::uint64_t> cursor(g.offsets.begin(), g.offsets.end() - 1);
+        for (auto& e : edges)
+            if (e.first != e.second) { g.targets[cursor[e.first]++] = e.second; g.targets[cursor[e.second]++] = e.first; }
+        g.sortAndDeduplicate();
+        return g;
+    }
+
+    void sortAndDeduplicate() {
+        std::uint64_t out = 0;
+        for (std::size_t u = 0; u + 1 < offsets.size(); ++u) {
+            auto first = targets.begin() + static_cast<std::ptrdiff_t>(offsets[u]);
+            auto last = targets.begin() + static_cast<std::ptrdiff_t>(offsets[u + 1]);
+            std::sort(first, last);
+            last = std::unique(first, last);
+            auto dest = targets.begin() + static_cast<std::ptrdiff_t>(out);
+            if (dest != first) std::copy(first, last, dest);
+            offsets[u] = out;
+            out += static_cast<std::uint64_t>(last - first);
+        }
+        offsets.back() = out;
+        targets.resize(out);
+    }
+
+    Vertex numVertices() const { return static_cast<Vertex>(offsets.size() - 1); }
+    std::uint64_t degree(Vertex u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+// Vertex relabelling kept in both directions.
+struct Permutation {
+    std::vector<Vertex> toNew;   // old ID -> new ID
+    std::vector<Vertex> toOld;   // new ID -> old ID
+
+    // order[i] is the old vertex that receives new ID i.
+    static Permutation fromOrder(std::vector<Vertex> order) {
+        Permutation p;
+        p.toNew.resize(order.size());
+        for (std::size_t i = 0; i < order.size(); ++i) p.toNew[order[i]] = static_cast<Vertex>(i);
+        p.toOld = std::move(order);
+        return p;
+    }
+    static Permutation identity(Vertex n) {
+        std::vector<Vertex> order(n);
+        std::iota(order.begin(), order.end(), Vertex{0});
+        return fromOrder(std::move(order));
+    }
+};
+
+Permutation reverseCuthillMcKee(const Csr& g) {
+    const Vertex n = g.numVertices();
+    std::vector<Vertex> byDegree(n), order;
+    std::iota(byDegree.begin(), byDegree.end(), Vertex{0});
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&](Vertex a, Vertex b) { return g.degree(a) < g.degree(b); });
+    std::vector<char> visited(n, 0);
+    std::vector<Vertex> fresh;
+    order.reserve(n);
+    for (Vertex start : byDegree) {
+        if (visited[start]) continue;
+        visited[start] = 1;
+        order.push_back(start);
+        for (std::size_t head = order.size() - 1; head < order.size(); ++head) {
+            Vertex u = order[head];
+            fresh.clear();
+            for (std::uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i)
+                if (!visited[g.targets[i]]) { visited[g.targets[i]] = 1; fresh.push_back(g.targets[i]); }
+            std::sort(fresh.begin(), fresh.end(), [&](Vertex a, Vertex b) { return g.degree(a) < g.degree(b); });
+            order.insert(order.end(), fresh.begin(), fresh.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return Permutation::fromOrder(std::move(order));
+}
+
+Permutation degreeSort(const Csr& g) {
+    std::vector<Vertex> order(g.numVertices());
+    std::iota(order.begin(), order.end(), Vertex{0});
+    std::stable_sort(order.begin(), order.end(), [&](Vertex a, Vertex b) { return g.degree(a) > g.degree(b); });
+    return Permutation::fromOrder(std::move(order));
+}
+
+Permutation hubCluster(const Csr& g) {
+    const Vertex n = g.numVertices();
+    const double average = n ? static_cast<double>(g.targets.size()) / n : 0.0;
+    std::vector<Vertex> order;
+    order.reserve(n);
+    for (Vertex u = 0; u < n; ++u) if (static_cast<double>(g.degree(u)) > average) order.push_back(u);
+    for (Vertex u = 0; u < n; ++u) if (static_cast<double>(g.degree(u)) <= average) order.push_back(u);
+    return Permutation::fromOrder(std::move(order));
+}
+
+Csr relabel(const Csr& g, const Permutation& p) {
+    const Vertex n = g.numVertices();
+    Csr r;
+    r.offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+    for (Vertex v = 0; v < n; ++v) r.offsets[v + 1] = r.offsets[v] + g.degree(p.toOld[v]);
+    r.targets.resize(g.targets.size());
+    for (Vertex v = 0; v < n; ++v) {
+        Vertex u = p.toOld[v];
+        Vertex* out = r.targets.data() + r.offsets[v];
+        for (std::uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) *out++ = p.toNew[g.targets[i]];
+        std::sort(r.targets.data() + r.offsets[v], out);
+    }
+    return r;
+}
+
+// ---------------------------------------------------------------------------
+// Kernels used to measure locality.
+// ---------------------------------------------------------------------------
+
+// Returns the sum of hop distances over reached vertices (a checksum).
+std::uint64_t bfs(const Csr& g, Vertex src) {
+    const Vertex UNREACHED = static_cast<Vertex>(-1);
+    std::vector<Vertex> dist(g.numVertices(), UNREACHED), queue{src};
+    queue.reserve(g.numVertices());
+    dist[src] = 0;
+    std::uint64_t sum = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        Vertex u = queue[head];
+        sum += dist[u];
+        for (std::uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i)
+            if (dist[g.targets[i]] == UNREACHED) { dist[g.targets[i]] = dist[u] + 1; queue.push_back(g.targets[i]); }
+    }
+    return sum;
+}
+
+// Pull-based PageRank with a fixed iteration count.
+std::vector<double> pageRank(const Csr& g, int iterations, double damping = 0.85) {
+    const Vertex n = g.numVertices();
+    std::vector<double> rank(n, 1.0 / n), contrib(n);
+    for (int it = 0; it < iterations; ++it) {
+        for (Vertex u = 0; u < n; ++u) contrib[u] = g.degree(u) ? rank[u] / static_cast<double>(g.degree(u)) : 0.0;
+        for (Vertex v = 0; v < n; ++v) {
+            double sum = 0;
+            for (std::uint64_t i = g.offsets[v]; i < g.offsets[v + 1]; ++i) sum += contrib[g.targets[i]];
+            rank[v] = (1.0 - damping) / n + damping * sum;
+        }
+    }
+    return rank;
+}
+
+// Counts each triangle once as u < v < w by merging sorted neighbour lists.
+std::uint64_t countTriangles(const Csr& g) {
+    std::uint64_t count = 0;
+    for (Vertex u = 0; u < g.numVertices(); ++u) {
+        const Vertex* uBegin = g.targets.data() + g.offsets[u];
+        const Vertex* uEnd = g.targets.data() + g.offsets[u + 1];
+        const Vertex* uFirst = std::upper_bound(uBegin, uEnd, u);
+        for (const Vertex* pv = uFirst; pv != uEnd; ++pv) {
+            Vertex v = *pv;
+            const Vertex* a = pv + 1;
+            const Vertex* b = std::upper_bound(g.targets.data() + g.offsets[v], g.targets.data() + g.offsets[v + 1], v);
+            const Vertex* bEnd = g.targets.data() + g.offsets[v + 1];
+            while (a != uEnd && b != bEnd) {
+                if (*a < *b) ++a;
+                else if (*b < *a) ++b;
+                else { ++count; ++a; ++b; }
+            }
+        }
+    }
+    return count;
+}
+
+// Mean |u - v| over all arcs: a rough proxy for how far apart neighbours live.
+double averageGap(const Csr& g) {
+    double sum = 0;
+    for (Vertex u = 0; u < g.numVertices(); ++u)
+        for (std::uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i)
+            sum += std::fabs(static_cast<double>(g.targets[i]) - static_cast<double>(u));
+    return g.targets.empty() ? 0.0 : sum / static_cast<double>(g.targets.size());
+}
+
+// ---------------------------------------------------------------------------
+// Inputs: both get randomly scrambled IDs, as if loaded from an external source.
+// ---------------------------------------------------------------------------
+
+std::uint64_t nextRandom(std::uint64_t& s) {
+    s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+    return s;
+}
+
+void scramble(Vertex n, std::vector<Edge>& edges, std::uint64_t seed) {
+    std::vector<Vertex> perm(n);
+    std::iota(perm.begin(), perm.end(), Vertex{0});
+    for (std::size_t i = n; i > 1; --i) std::swap(perm[i - 1], perm[nextRandom(seed) % i]);
+    for (auto& e : edges) e = {perm[e.first], perm[e.second]};
+}
+
+// 2D grid with diagonals (road network / mesh stand-in).
+std::vector<Edge> meshEdges(Vertex side) {
+    std::vector<Edge> edges;
+    for (Vertex r = 0; r < side; ++r)
+        for (Vertex c = 0; c < side; ++c) {
+            Vertex u = r * side + c;
+            if (c + 1 < side) edges.emplace_back(u, u + 1);
+            if (r + 1 < side) edges.emplace_back(u, u + side);
+            if (r + 1 < side && c + 1 < side) edges.emplace_back(u, u + side + 1);
+        }
+    return edges;
+}
+
+// Power-law graph (Graph500 R-MAT parameters).
+std::vector<Edge> rmatEdges(int scale, int edgeFactor, std::uint64_t seed) {
+    std::vector<Edge> edges((std::size_t{1} << scale) * static_cast<std::size_t>(edgeFactor));
+    for (auto& e : edges) {
+        Vertex u = 0, v = 0;
+        for (int bit = 0; bit < scale; ++bit) {
+            double p = static_cast<double>(nextRandom(seed) >> 11) / 9007199254740992.0;
+            if (p < 0.57) {}
+            else if (p < 0.76) v |= Vertex{1} << bit;
+            else if (p < 0.95) u |= Vertex{1} << bit;
+            else { u |= Vertex{1} << bit; v |= Vertex{1} << bit; }
+        }
+        e = {u, v};
+    }
+    return edges;
+}
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Runs every kernel on the original labels and on each reordering.
+bool benchmark(const std::string& name, const Csr& g, int pageRankIterations) {
+    std::cout << "\n" << name << ": " << g.numVertices() << " vertices, " << g.targets.size() / 2 << " edges\n"
+              << "ordering      reorder(ms)  avg gap    BFS(ms)  PageRank(ms)  triangles(ms)\n";
+    Vertex src = 0;   // highest-degree vertex (original ID), translated through each permutation
+    for (Vertex u = 1; u < g.numVertices(); ++u) if (g.degree(u) > g.degree(src)) src = u;
+    std::uint64_t bfsRef = 0, triRef = 0;
+    std::vector<double> rankRef;
+    double base[3] = {0, 0, 0};
+    bool ok = true;
+
+    struct Ordering { const char* name; Permutation (*make)(const Csr&); };
+    const Ordering orderings[] = {
+        {"original", [](const Csr& x) { return Permutation::identity(x.numVertices()); }},
+        {"RCM", reverseCuthillMcKee},
+        {"degree", degreeSort},
+        {"hub-cluster", hubCluster},
+    };
+    for (const Ordering& o : orderings) {
+        Permutation p;
+        Csr r;
+        double reorderMs = timeMs([&] { p = o.make(g); r = relabel(g, p); });
+        std::uint64_t bfsSum = 0, triangles = 0;
+        std::vector<double> rank;
+        double t[3];
+        t[0] = timeMs([&] { bfsSum = bfs(r, p.toNew[src]); });
+        t[1] = timeMs([&] { rank = pageRank(r, pageRankIterations); });
+        t[2] = timeMs([&] { triangles = countTriangles(r); });
+
+        // Results must not depend on the labelling (ranks compared via toNew).
+        if (rankRef.empty()) { bfsRef = bfsSum; triRef = triangles; rankRef = rank; std::copy(t, t + 3, base); }
+        double maxDiff = 0;
+        for (Vertex v = 0; v < g.numVertices(); ++v) maxDiff = std::max(maxDiff, std::fabs(rank[p.toNew[v]] - rankRef[v]));
+        if (bfsSum != bfsRef || triangles != triRef || maxDiff > 1e-12) { std::cout << "  result mismatch for " << o.name << "\n"; ok = false; }
+
+        std::cout << std::left << std::setw(12) << o.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << reorderMs << std::setw(10) << averageGap(r);
+        for (int k = 0; k < 3; ++k)
+            std::cout << std::setw(9) << t[k] << " (" << std::setprecision(2) << base[k] / t[k] << "x)" << std::setprecision(1);
+        std::cout << "\n";
+    }
+    std::cout << "  triangles=" << triRef << "\n";
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Vertex reordering ===\n";
+    // Path 0-1-2-3-4-5 labelled in scrambled order.
+    std::vector<Edge> path{{4, 0}, {0, 5}, {5, 2}, {2, 3}, {3, 1}};
+    Csr small = Csr::fromEdges(6, path);
+    Permutation p = reverseCuthillMcKee(small);
+    std::cout << "RCM old->new:";
+    for (Vertex u = 0; u < 6; ++u) std::cout << ' ' << u << "->" << p.toNew[u];
+    Csr r = relabel(small, p);
+    std::cout << "\nrelabelled edges:";
+    for (Vertex u = 0; u < 6; ++u)
+        for (std::uint64_t i = r.offsets[u]; i < r.offsets[u + 1]; ++i)
+            if (u < r.targets[i]) std::cout << " (" << u << ',' << r.targets[i] << ')';
+    std::cout << "\n";
+
+    // Usage: ./VertexReordering [meshSide] [rmatScale] [pageRankIterations]
+    Vertex side = argc > 1 ? static_cast<Vertex>(std::strtoul(argv[1], nullptr, 10)) : 1000;
+    int scale = argc > 2 ? std::atoi(argv[2]) : 16;
+    int iterations = argc > 3 ? std::atoi(argv[3]) : 10;
+
+    std::vector<Edge> mesh = meshEdges(side);
+    scramble(side * side, mesh, 0x1234567);
+    bool ok = benchmark("Mesh (scrambled IDs)", Csr::fromEdges(side * side, mesh), iterations);
+
+    std::vector<Edge> rmat = rmatEdges(scale, 16, 0x2545f4914f6cdd1dULL);
+    scramble(Vertex{1} << scale, rmat, 0x7654321);
+    ok = benchmark("R-MAT (scrambled IDs)", Csr::fromEdges(Vertex{1} << scale, rmat), iterations) && ok;
+    return ok ? 0 : 1;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 VertexReordering.cpp -o VertexReordering */
@@ -0,0 +1,260 @@
+/**
+ * @file ConcurrentHashTable.cpp
+ * @brief Lock-striped concurrent hash map with per-segment reader-writer locks.
+ * @date 2026-10-17
+ *
+ * Instead of one global mutex around a whole table (see
+ * 07_Multithreading/02_Synchronization/MutexExample.cpp), keys are sharded
+ * across N segments by the top bits of their hash. Each segment:
+ * - is aligned to its own cache line, so locks of neighbouring segments do
+ *   not false-share,
+ * - has its own std::shared_mutex (many readers or one writer),
+ * - is a small linear-probing table that grows independently of the others.
+ *
+ * multi_get() groups a batch of keys by segment and takes each lock once.
+ */
+
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <optional>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+constexpr std::size_t CACHE_LINE = 64;
+
+template<class K, class V, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class ConcurrentHashTable {
+    struct alignas(CACHE_LINE) Segment {
+        mutable std::shared_mutex mtx;
+        std::vector<std::pair<K, V>> slots;
+        std::vector<std::uint8_t> used;
+        std::size_t count = 0;
+
+        Segment() : slots(16), used(16, 0) {}
+        std::size_t mask() const { return slots.size() - 1; }
+
+        std::size_t findIndex(const K& k, std::size_t h, const Eq& eq) const {
+            for (std::size_t i = h & mask(); used[i]; i = (i + 1) & mask())
+                if (eq(slots[i].first, k)) return i;
+            return SIZE_MAX;
+        }
+        void place(std::pair<K, V>&& kv, std::size_t h) {
+            std::size_t i = h & mask();
+            while (used[i]) i = (i + 1) & mask();
+            slots[i] = std::move(kv);
+            used[i] = 1;
+        }
+        template<class H>
+        void grow(const H& hashOf) {
+            std::vector<std::pair<K, V>> oldSlots(slots.size() * 2);
+            std::vector<std::uint8_t> oldUsed(used.size() * 2, 0);
+            oldSlots.swap(slots);
+            oldUsed.swap(used);
+            for (std::size_t i = 0; i < oldSlots.size(); ++i)
+                if (oldUsed[i]) place(std::move(oldSlots[i]), hashOf(oldSlots[i].first));
+        }
+    };
+
+    std::unique_ptr<Segment[]> segments;
+    std::size_t segmentBits;
+    Hash hasher;
+    Eq eq;
+
+    std::size_t hashOf(const K& k) const {
+        std::uint64_t h = static_cast<std::uint64_t>(hasher(k));
+        h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+    // Top bits pick the segment, low bits pick the slot inside it.
+    std::size_t segmentIndex(std::size_t h) const {
+        return segmentBits ? h >> (sizeof(std::size_t) * 8 - segmentBits) : 0;
+    }
+    Segment& segmentFor(std::size_t h) const { return segments[segmentIndex(h)]; }
+
+public:
+    // segmentCount is rounded up to a power of two.
+    explicit ConcurrentHashTable(std::size_t segmentCount = 64) : segmentBits(0) {
+        while ((std::size_t{1} << segmentBits) < segmentCount) ++segmentBits;
+        segments = std::make_unique<Segment[]>(std::size_t{1} << segmentBits);
+    }
+
+    std::size_t segment_count() const { return std::size_t{1} << segmentBits; }
+
+    // Returns true if k was inserted, false if an existing value was replaced.
+    bool insert_or_assign(const K& k, V v) {
+        std::size_t h = hashOf(k);
+        Segment& s = segmentFor(h);
+        std::unique_lock<std::shared_mutex> lock(s.mtx);
+        std::size_t i = s.findIndex(k, h, eq);
+        if (i != SIZE_MAX) { s.slots[i].second = std::move(v); return false; }
+        if ((s.count + 1) * 4 > s.slots.size() * 3) s.grow([this](const K& key) { return hashOf(key); });
+        s.place(std::pair<K, V>(k, std::move(v)), h);
+        ++s.count;
+        return true;
+    }
+
+    std::optional<V> find(const K& k) const {
+        std::size_t h = hashOf(k);
+        const Segment& s = segmentFor(h);
+        std::shared_lock<std::shared_mutex> lock(s.mtx);
+        std::size_t i = s.findIndex(k, h, eq);
+        if (i == SIZE_MAX) return std::nullopt;
+        return s.slots[i].second;
+    }
+
+    bool erase(const K& k) {
+        std::size_t h = hashOf(k);
+        Segment& s = segmentFor(h);
+        std::unique_lock<std::shared_mutex> lock(s.mtx);
+        std::size_t hole = s.findIndex(k, h, eq);
+        if (hole == SIZE_MAX) return false;
+        // Backward-shift the rest of the cluster so lookups never need tombstones.
+        std::size_t mask = s.mask();
+        for (std::size_t j = (hole + 1) & mask; s.used[j]; j = (j + 1) & mask) {
+            std::size_t home = hashOf(s.slots[j].first) & mask;
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                s.slots[hole] = std::move(s.slots[j]);
+                hole = j;
+            }
+        }
+        s.slots[hole] = std::pair<K, V>();
+        s.used[hole] = 0;
+        --s.count;
+        return true;
+    }
+
+    // Looks up a batch of keys; out[i] corresponds to keys[i]. Keys are bucketed
+    // by segment first so each segment lock is acquired at most once.
+    std::vector<std::optional<V>> multi_get(const std::vector<K>& keys) const {
+        std::vector<std::optional<V>> out(keys.size());
+        std::vector<std::size_t> hashes(keys.size());
+        std::vector<std::size_t> order(keys.size());
+        std::vector<std::size_t> start(segment_count() + 1, 0);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            hashes[i] = hashOf(keys[i]);
+            ++start[segmentIndex(hashes[i]) + 1];
+        }
+        for (std::size_t s = 0; s < segment_count(); ++s) start[s + 1] += start[s];
+        std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            order[fill[segmentIndex(hashes[i])]++] = i;
+
+        for (std::size_t s = 0; s < segment_count(); ++s) {
+            if (start[s] == start[s + 1]) continue;
+            const Segment& seg = segments[s];
+            std::shared_lock<std::shared_mutex> lock(seg.mtx);
+            for (std::size_t j = start[s]; j < start[s + 1]; ++j) {
+                std::size_t i = order[j];
+                std::size_t idx = seg.findIndex(keys[i], hashes[i], eq);
+                if (idx != SIZE_MAX) out[i] = seg.slots[idx].second;
+            }
+        }
+        return out;
+    }
+
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (std::size_t s = 0; s < segment_count(); ++s) {
+            std::shared_lock<std::shared_mutex> lock(segments[s].mtx);
+            total += segments[s].count;
+        }
+        return total;
+    }
+};
+
+// Baseline: one std::mutex around std::unordered_map.
+template<class K, class V>
+class GlobalLockMap {
+    mutable std::mutex mtx;
+    std::unordered_map<K, V> map;
+public:
+    void insert_or_assign(const K& k, V v) { std::lock_guard<std::mutex> lock(mtx); map[k] = std::move(v); }
+    std::optional<V> find(const K& k) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = map.find(k);
+        if (it == map.end()) return std::nullopt;
+        return it->second;
+    }
+    bool erase(const K& k) { std::lock_guard<std::mutex> lock(mtx); return map.erase(k) > 0; }
+};
+
+static std::uint64_t splitmix64(std::uint64_t& s) {
+    std::uint64_t z = (s += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Runs opsPerThread random operations per thread over a key space of keyRange;
+// writePercent of them are writes (half insert_or_assign, half erase).
+template<class Map>
+static double throughputMops(Map& map, int threads, int writePercent, std::size_t keyRange, std::size_t opsPerThread) {
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> sink{0};
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::uint64_t seed = static_cast<std::uint64_t>(t) * 7919 + 1;
+            std::size_t local = 0;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (std::size_t i = 0; i < opsPerThread; ++i) {
+                std::uint64_t r = splitmix64(seed);
+                std::uint64_t key = r % keyRange;
+                int roll = static_cast<int>((r >> 40) % 100);
+                if (roll < writePercent / 2) map.insert_or_assign(key, r);
+                else if (roll < writePercent) map.erase(key);
+                else if (map.find(key)) ++local;
+            }
+            sink += local;
+        });
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& th : pool) th.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return static_cast<double>(opsPerThread) * threads / sec / 1e6;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Lock-striped ConcurrentHashTable ===\n";
+    ConcurrentHashTable<std::string, int> table(16);
+    table.insert_or_assign("alpha", 1);
+    table.insert_or_assign("beta", 2);
+    table.insert_or_assign("alpha", 10);
+    auto batch = table.multi_get({"alpha", "beta", "gamma"});
+    std::cout << "alpha=" << batch[0].value() << " beta=" << batch[1].value()
+              << " gamma found? " << batch[2].has_value() << '\n';
+    table.erase("beta");
+    std::cout << "size after erase=" << table.size() << '\n';
+
+    // Usage: ./ConcurrentHashTable [maxThreads] [opsPerThread]
+    int maxThreads = argc > 1 ? std::atoi(argv[1]) : 64;
+    std::size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    const std::size_t keyRange = 1 << 20;
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n"
+              << "threads  write%  striped Mops/s  global-mutex Mops/s\n";
+    for (int writePercent : {5, 20, 50}) {
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            ConcurrentHashTable<std::uint64_t, std::uint64_t> striped(256);
+            GlobalLockMap<std::uint64_t, std::uint64_t> global;
+            for (std::uint64_t k = 0; k < keyRange; k += 2) { striped.insert_or_assign(k, k); global.insert_or_assign(k, k); }
+            double a = throughputMops(striped, threads, writePercent, keyRange, ops);
+            double b = throughputMops(global, threads, writePercent, keyRange, ops);
+            std::cout << threads << "\t " << writePercent << "\t " << a << "\t\t " << b << '\n';
+        }
+    }
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 ConcurrentHashTable.cpp -o ConcurrentHashTable */
@@ -0,0 +1,300 @@
+/**
+ * @file CuckooHashSet.cpp
+ * @brief Concurrent bucketized cuckoo hash set with lock-free optimistic readers.
+ * @date 2026-10-17
+ *
+ * Every key lives in one of exactly two buckets (chosen by two hash functions),
+ * and each bucket holds 4 keys in a single cache line. A lookup therefore reads
+ * at most 2 cache lines, no matter how full the table is.
+ *
+ * Concurrency:
+ * - Each bucket has a version counter that doubles as its lock (odd = locked).
+ * - contains() never locks: it snapshots both bucket versions, scans the keys
+ *   and retries only if a writer touched either bucket meanwhile (seqlock).
+ * - Writers lock at most two buckets at a time, always in index order.
+ * - When both buckets are full, insert() runs a breadth-first search for a
+ *   short chain of displacements ("cuckoo path") ending at a free slot, then
+ *   applies it backwards, one locked bucket pair per move.
+ *
+ * The bucket count is fixed at construction; insert() returns false when no
+ * cuckoo path exists (the table is effectively full, typically > 95% load).
+ */
+
+#include <iostream>
+#include <vector>
+#include <unordered_set>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <shared_mutex>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <algorithm>
+
+template<class K, class Hash = std::hash<K>>
+class CuckooHashSet {
+    static_assert(std::is_trivially_copyable<K>::value, "keys are copied through std::atomic");
+    static constexpr int SLOTS = 4;
+    static constexpr int MAX_BFS_NODES = 512;
+
+    struct alignas(64) Bucket {
+        std::atomic<std::uint32_t> version{0};
+        std::atomic<std::uint8_t> occupied{0};   // bit i set => keys[i] holds a key
+        std::atomic<K> keys[SLOTS];
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    std::size_t mask;
+    Hash hasher;
+
+    std::uint64_t mix(std::uint64_t h) const {
+        h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+    void bucketsOf(const K& k, std::size_t& b1, std::size_t& b2) const {
+        std::uint64_t h = mix(static_cast<std::uint64_t>(hasher(k)));
+        b1 = static_cast<std::size_t>(h) & mask;
+        b2 = static_cast<std::size_t>(mix(h ^ 0x5bd1e9955bd1e995ULL)) & mask;
+    }
+    std::size_t altBucket(const K& k, std::size_t b) const {
+        std::size_t b1, b2;
+        bucketsOf(k, b1, b2);
+        return b == b1 ? b2 : b1;
+    }
+
+    void lock(std::size_t b) {
+        std::atomic<std::uint32_t>& v = buckets[b].version;
+        while (true) {
+            std::uint32_t cur = v.load(std::memory_order_relaxed);
+            if (!(cur & 1) && v.compare_exchange_weak(cur, cur + 1, std::memory_order_acquire)) break;
+            std::this_thread::yield();
+        }
+        // Seqlock writer: the odd version must be visible before any data store.
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    void unlock(std::size_t b) { buckets[b].version.fetch_add(1, std::memory_order_release); }
+    void lockPair(std::size_t a, std::size_t b) {
+        if (a > b) std::swap(a, b);
+        lock(a);
+        if (a != b) lock(b);
+    }
+    void unlockPair(std::size_t a, std::size_t b) {
+        unlock(a);
+        if (a != b) unlock(b);
+    }
+
+    // Caller holds the bucket lock (or is a validated optimistic reader).
+    int findSlot(std::size_t b, const K& k) const {
+        const Bucket& bk = buckets[b];
+        std::uint8_t occ = bk.occupied.load(std::memory_order_relaxed);
+        for (int i = 0; i < SLOTS; ++i)
+            if ((occ >> i & 1) && bk.keys[i].load(std::memory_order_relaxed) == k) return i;
+        return -1;
+    }
+    int freeSlot(std::size_t b) const {
+        std::uint8_t occ = buckets[b].occupied.load(std::memory_order_relaxed);
+        for (int i = 0; i < SLOTS; ++i) if (!(occ >> i & 1)) return i;
+        return -1;
+    }
+    void put(std::size_t b, int slot, const K& k) {
+        buckets[b].keys[slot].store(k, std::memory_order_relaxed);
+        buckets[b].occupied.fetch_or(static_cast<std::uint8_t>(1u << slot), std::memory_order_relaxed);
+    }
+    void clear(std::size_t b, int slot) {
+        buckets[b].occupied.fetch_and(static_cast<std::uint8_t>(~(1u << slot)), std::memory_order_relaxed);
+    }
+
+    struct PathNode { std::size_t bucket; int slot; int parent; };
+
+    // Breadth-first search (without locks) for a chain of moves that frees a
+    // slot in b1 or b2. Returns the chain from the start bucket to the bucket
+    // with a free slot; empty if none was found.
+    std::vector<PathNode> findCuckooPath(std::size_t b1, std::size_t b2) const {
+        std::vector<PathNode> nodes;
+        nodes.push_back({b1, -1, -1});
+        nodes.push_back({b2, -1, -1});
+        for (std::size_t head = 0; head < nodes.size() && nodes.size() < MAX_BFS_NODES; ++head) {
+            std::size_t b = nodes[head].bucket;
+            std::uint8_t occ = buckets[b].occupied.load(std::memory_order_relaxed);
+            for (int s = 0; s < SLOTS; ++s) {
+                if (!(occ >> s & 1)) continue;
+                std::size_t alt = altBucket(buckets[b].keys[s].load(std::memory_order_relaxed), b);
+                nodes.push_back({alt, s, static_cast<int>(head)});
+                if (freeSlot(alt) >= 0) {
+                    // Walk parents back to the root: path[i].slot moves to path[i+1].bucket.
+                    std::vector<PathNode> path;
+                    for (int n = static_cast<int>(nodes.size()) - 1; n >= 0; n = nodes[n].parent) path.push_back(nodes[n]);
+                    std::vector<PathNode> forward(path.rbegin(), path.rend());
+                    for (std::size_t i = 0; i + 1 < forward.size(); ++i) forward[i].slot = forward[i + 1].slot;
+                    forward.back().slot = -1;
+                    return forward;
+                }
+            }
+        }
+        return {};
+    }
+
+    // Applies moves from the free end backwards so the moved key is never absent.
+    bool applyPath(const std::vector<PathNode>& path) {
+        for (std::size_t i = path.size() - 1; i-- > 0;) {
+            std::size_t from = path[i].bucket, to = path[i + 1].bucket;
+            int s = path[i].slot;
+            lockPair(from, to);
+            bool ok = (buckets[from].occupied.load(std::memory_order_relaxed) >> s & 1);
+            K k{};
+            int dst = -1;
+            if (ok) {
+                k = buckets[from].keys[s].load(std::memory_order_relaxed);
+                ok = altBucket(k, from) == to && (dst = freeSlot(to)) >= 0;
+            }
+            if (ok) { put(to, dst, k); clear(from, s); }
+            unlockPair(from, to);
+            if (!ok) return false;   // another writer changed the path; caller retries
+        }
+        return true;
+    }
+
+public:
+    // bucketCount is rounded up to a power of two; capacity is 4 keys per bucket.
+    explicit CuckooHashSet(std::size_t bucketCount = 1024) {
+        std::size_t n = 2;
+        while (n < bucketCount) n <<= 1;
+        buckets = std::make_unique<Bucket[]>(n);
+        mask = n - 1;
+    }
+
+    std::size_t capacity() const { return (mask + 1) * SLOTS; }
+
+    // Lock-free: reads two cache lines and validates them with the bucket versions.
+    bool contains(const K& k) const {
+        std::size_t b1, b2;
+        bucketsOf(k, b1, b2);
+        while (true) {
+            std::uint32_t v1 = buckets[b1].version.load(std::memory_order_acquire);
+            std::uint32_t v2 = buckets[b2].version.load(std::memory_order_acquire);
+            if ((v1 | v2) & 1) { std::this_thread::yield(); continue; }
+            bool found = findSlot(b1, k) >= 0 || findSlot(b2, k) >= 0;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (buckets[b1].version.load(std::memory_order_relaxed) == v1 &&
+                buckets[b2].version.load(std::memory_order_relaxed) == v2) return found;
+        }
+    }
+
+    // Returns false if k is already present or the table is full.
+    bool insert(const K& k) {
+        std::size_t b1, b2;
+        bucketsOf(k, b1, b2);
+        while (true) {
+            lockPair(b1, b2);
+            if (findSlot(b1, k) >= 0 || findSlot(b2, k) >= 0) { unlockPair(b1, b2); return false; }
+            int s = freeSlot(b1);
+            std::size_t b = b1;
+            if (s < 0) { s = freeSlot(b2); b = b2; }
+            if (s >= 0) { put(b, s, k); unlockPair(b1, b2); return true; }
+            unlockPair(b1, b2);
+
+            std::vector<PathNode> path = findCuckooPath(b1, b2);
+            if (path.empty()) return false;
+            applyPath(path);   // success or not, re-check both buckets from the top
+        }
+    }
+
+    bool erase(const K& k) {
+        std::size_t b1, b2;
+        bucketsOf(k, b1, b2);
+        lockPair(b1, b2);
+        bool removed = false;
+        for (std::size_t b : {b1, b2}) {
+            int s = findSlot(b, k);
+            if (s >= 0) { clear(b, s); removed = true; break; }
+        }
+        unlockPair(b1, b2);
+        return removed;
+    }
+};
+
+static std::uint64_t splitmix64(std::uint64_t& s) {
+    std::uint64_t z = (s += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Baseline for the benchmark: std::unordered_set behind a reader-writer lock.
+struct SharedLockSet {
+    mutable std::shared_mutex mtx;
+    std::unordered_set<std::uint64_t> set;
+    bool contains(std::uint64_t k) const { std::shared_lock<std::shared_mutex> l(mtx); return set.count(k) != 0; }
+    bool insert(std::uint64_t k) { std::unique_lock<std::shared_mutex> l(mtx); return set.insert(k).second; }
+    bool erase(std::uint64_t k) { std::unique_lock<std::shared_mutex> l(mtx); return set.erase(k) != 0; }
+};
+
+// N reader threads run contains() while one writer keeps erasing and
+// re-inserting keys; returns reader throughput in Mops/s.
+template<class Set>
+static double readerMops(Set& set, const std::vector<std::uint64_t>& keys, int readers, std::size_t opsPerReader) {
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> hits{0};
+    std::thread writer([&] {
+        std::size_t i = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            std::uint64_t k = keys[i++ % keys.size()];
+            set.erase(k);
+            set.insert(k);
+        }
+    });
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int r = 0; r < readers; ++r) {
+        pool.emplace_back([&, r] {
+            std::uint64_t seed = static_cast<std::uint64_t>(r) + 1;
+            std::size_t local = 0;
+            for (std::size_t i = 0; i < opsPerReader; ++i) local += set.contains(keys[splitmix64(seed) % keys.size()]);
+            hits += local;
+        });
+    }
+    for (auto& t : pool) t.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    stop = true;
+    writer.join();
+    return static_cast<double>(opsPerReader) * readers / sec / 1e6;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Concurrent cuckoo hash set ===\n";
+    CuckooHashSet<int> small(4);
+    int inserted = 0;
+    for (int k = 0; k < 40 && small.insert(k); ++k) ++inserted;
+    std::cout << "Inserted " << inserted << " of capacity " << small.capacity()
+              << " before the table filled up\n";
+    std::cout << "Contains 3? " << small.contains(3) << ", erase 3 -> " << small.erase(3)
+              << ", contains 3? " << small.contains(3) << '\n';
+
+    // Usage: ./CuckooHashSet [maxReaders] [opsPerReader]
+    int maxReaders = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    std::size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    const std::size_t buckets = 1 << 18;
+    std::vector<std::uint64_t> keys;
+    CuckooHashSet<std::uint64_t> cuckoo(buckets);
+    SharedLockSet locked;
+    std::uint64_t seed = 99;
+    while (keys.size() < buckets * 4 * 9 / 10) {   // 90% load
+        std::uint64_t k = splitmix64(seed);
+        if (!cuckoo.insert(k)) break;
+        locked.insert(k);
+        keys.push_back(k);
+    }
+    std::cout << "keys=" << keys.size() << " load=" << static_cast<double>(keys.size()) / static_cast<double>(cuckoo.capacity()) << '\n'
+              << "readers  cuckoo Mops/s  shared_mutex Mops/s (1 concurrent writer)\n";
+    for (int r = 1; r <= maxReaders; r *= 2)
+        std::cout << r << "\t " << readerMops(cuckoo, keys, r, ops) << "\t\t " << readerMops(locked, keys, r, ops) << '\n';
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 CuckooHashSet.cpp -o CuckooHashSet */
@@ -0,0 +1,202 @@
+/**
+ * @file IncrementalHashSet.cpp
+ * @brief Chained hash set that grows by incremental (amortized) rehashing.
+ * @date 2026-10-17
+ *
+ * std::unordered_set rehashes every element in one step when the load factor
+ * is exceeded (see example3_LoadFactorRehash in
+ * 01_STL_Containers/03_UnorderedContainers/UnorderedSetExample.cpp), so one
+ * unlucky insert pays O(n). Here growth only allocates the new bucket array;
+ * the elements are migrated a few buckets at a time by later operations:
+ *
+ * - While migrating, the set owns two bucket arrays. Buckets of the old array
+ *   below `migrated` have already been moved to the new array.
+ * - New keys always go into the new array; lookups and erases check the old
+ *   bucket (if not migrated yet) and then the new one.
+ * - Every insert/find/erase migrates up to MIGRATE_BUCKETS non-empty buckets,
+ *   so the worst-case cost of an operation is bounded regardless of size.
+ * - Nodes are relinked, never copied, and bucket arrays come from calloc so
+ *   large arrays are zero pages supplied lazily by the OS.
+ */
+
+#include <iostream>
+#include <vector>
+#include <unordered_set>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+template<class K, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class IncrementalHashSet {
+    struct Node {
+        K key;
+        std::size_t hash;
+        Node* next;
+    };
+    struct Table {
+        Node** buckets = nullptr;
+        std::size_t mask = 0;
+        std::size_t size() const { return buckets ? mask + 1 : 0; }
+    };
+    static constexpr std::size_t MIGRATE_BUCKETS = 4;
+    static constexpr std::size_t MAX_EMPTY_VISITS = MIGRATE_BUCKETS * 10;
+
+    Table cur;        // receives all inserts
+    Table old;        // non-empty only while migrating
+    std::size_t migrated = 0;
+    std::size_t count = 0;
+    Hash hasher;
+    Eq eq;
+
+    static Table makeTable(std::size_t n) {
+        Table t;
+        t.buckets = static_cast<Node**>(std::calloc(n, sizeof(Node*)));
+        if (!t.buckets) throw std::bad_alloc();
+        t.mask = n - 1;
+        return t;
+    }
+    static void freeTable(Table& t) {
+        for (std::size_t i = 0; i < t.size(); ++i) {
+            Node* n = t.buckets[i];
+            while (n) { Node* next = n->next; delete n; n = next; }
+        }
+        std::free(t.buckets);
+        t = Table{};
+    }
+
+    std::size_t hashOf(const K& k) const {
+        std::uint64_t h = static_cast<std::uint64_t>(hasher(k));
+        h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+    bool rehashing() const { return old.buckets != nullptr; }
+
+    // Moves up to MIGRATE_BUCKETS non-empty old buckets into the new table.
+    void migrateStep() {
+        if (!rehashing()) return;
+        std::size_t moved = 0, visited = 0;
+        while (migrated < old.size() && moved < MIGRATE_BUCKETS && visited < MAX_EMPTY_VISITS) {
+            Node* n = old.buckets[migrated];
+            old.buckets[migrated++] = nullptr;
+            ++visited;
+            if (!n) continue;
+            while (n) {
+                Node* next = n->next;
+                Node*& head = cur.buckets[n->hash & cur.mask];
+                n->next = head;
+                head = n;
+                n = next;
+            }
+            ++moved;
+        }
+        if (migrated == old.size()) { std::free(old.buckets); old = Table{}; }
+    }
+
+    Node** findLink(const K& k, std::size_t h) {
+        if (rehashing() && (h & old.mask) >= migrated)
+            for (Node** link = &old.buckets[h & old.mask]; *link; link = &(*link)->next)
+                if ((*link)->hash == h && eq((*link)->key, k)) return link;
+        for (Node** link = &cur.buckets[h & cur.mask]; *link; link = &(*link)->next)
+            if ((*link)->hash == h && eq((*link)->key, k)) return link;
+        return nullptr;
+    }
+
+    void startGrowth() {
+        // A new growth while the previous one is still running is only possible
+        // under heavy erase/insert churn; finish the old one first.
+        while (rehashing()) migrateStep();
+        Table next = makeTable(cur.size() * 2);   // if this throws, the set is unchanged
+        old = cur;
+        cur = next;
+        migrated = 0;
+    }
+
+public:
+    explicit IncrementalHashSet(std::size_t buckets = 16) {
+        std::size_t n = 16;
+        while (n < buckets) n <<= 1;
+        cur = makeTable(n);
+    }
+    ~IncrementalHashSet() { freeTable(old); freeTable(cur); }
+    IncrementalHashSet(const IncrementalHashSet&) = delete;
+    IncrementalHashSet& operator=(const IncrementalHashSet&) = delete;
+
+    std::size_t size() const { return count; }
+    bool is_rehashing() const { return rehashing(); }
+    std::size_t bucket_count() const { return cur.size(); }
+
+    bool insert(const K& k) {
+        migrateStep();
+        std::size_t h = hashOf(k);
+        if (findLink(k, h)) return false;
+        if (count + 1 > cur.size()) startGrowth();   // max load factor 1.0
+        Node*& head = cur.buckets[h & cur.mask];
+        head = new Node{k, h, head};
+        ++count;
+        return true;
+    }
+
+    bool contains(const K& k) {
+        migrateStep();
+        return findLink(k, hashOf(k)) != nullptr;
+    }
+
+    bool erase(const K& k) {
+        migrateStep();
+        Node** link = findLink(k, hashOf(k));
+        if (!link) return false;
+        Node* n = *link;
+        *link = n->next;
+        delete n;
+        --count;
+        return true;
+    }
+};
+
+// Records every insert latency and prints percentiles plus a log2 histogram.
+template<class Set>
+static void latencyBenchmark(const char* name, Set& set, std::size_t n) {
+    std::vector<std::uint32_t> ns(n);
+    std::uint64_t key = 0x12345;
+    for (std::size_t i = 0; i < n; ++i) {
+        key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+        auto t0 = std::chrono::steady_clock::now();
+        set.insert(key);
+        auto t1 = std::chrono::steady_clock::now();
+        ns[i] = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+    std::vector<std::size_t> hist(33, 0);
+    for (std::uint32_t v : ns) ++hist[v ? 32 - __builtin_clz(v) : 0];
+    std::sort(ns.begin(), ns.end());
+    auto pct = [&](double p) { return ns[static_cast<std::size_t>(p * static_cast<double>(n - 1))]; };
+    std::cout << name << ": p50=" << pct(0.5) << "ns p99=" << pct(0.99) << "ns p99.9=" << pct(0.999)
+              << "ns max=" << ns.back() << "ns\n  histogram (<2^k ns: count):";
+    for (std::size_t b = 0; b < hist.size(); ++b) if (hist[b]) std::cout << " 2^" << b << ':' << hist[b];
+    std::cout << '\n';
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Incremental rehashing hash set ===\n";
+    IncrementalHashSet<int> small;
+    for (int k = 0; k < 40; ++k) {
+        bool wasRehashing = small.is_rehashing();
+        small.insert(k);
+        if (!wasRehashing && small.is_rehashing())
+            std::cout << "insert " << k << ": started migrating into " << small.bucket_count() << " buckets\n";
+    }
+    std::cout << "Contains 17? " << small.contains(17) << ", erase 17 -> " << small.erase(17)
+              << ", size=" << small.size() << '\n';
+
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    IncrementalHashSet<std::uint64_t> incremental;
+    std::unordered_set<std::uint64_t> standard;
+    latencyBenchmark("IncrementalHashSet", incremental, n);
+    latencyBenchmark("std::unordered_set", standard, n);
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 IncrementalHashSet.cpp -o IncrementalHashSet */
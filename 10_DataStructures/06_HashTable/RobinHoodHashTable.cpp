@@ -0,0 +1,251 @@
+/**
+ * @file RobinHoodHashTable.cpp
+ * @brief Robin Hood open addressing with backward-shift deletion and probe statistics.
+ * @date 2026-10-17
+ *
+ * Every slot remembers how far it sits from its home bucket (probe distance).
+ * On insert, an incoming element that has travelled further than the resident
+ * "steals" the slot and the resident continues probing ("take from the rich").
+ * This keeps probe lengths short and uniform even at load factors >= 0.9:
+ *
+ * - Lookups stop as soon as they reach a slot whose distance is smaller than
+ *   the distance probed so far, so misses are as cheap as hits.
+ * - Erase shifts the following cluster back by one (no tombstones).
+ * - probeHistogram() reports how many elements live at each distance.
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <stdexcept>
+
+template<class K, class V, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class RobinHoodHashTable {
+    using Slot = std::pair<K, V>;
+    // dist[i] == 0 means empty, otherwise the element is dist[i] - 1 slots from home.
+    static constexpr std::uint8_t MAX_DIST = 255;
+    // If a probe still exceeds MAX_DIST below load 1/SPARSE_LIMIT, the hasher
+    // is degenerate and growing further would not help.
+    static constexpr std::size_t SPARSE_LIMIT = 64;
+
+    std::vector<std::uint8_t> dist;
+    Slot* slots = nullptr;
+    std::size_t mask = 0;
+    std::size_t count = 0;
+    double maxLoad;
+    Hash hasher;
+    Eq eq;
+
+    std::size_t home(const K& k) const {
+        std::uint64_t h = static_cast<std::uint64_t>(hasher(k));
+        h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h) & mask;
+    }
+
+    // Allocates empty arrays for cap slots without touching the table.
+    static std::pair<std::vector<std::uint8_t>, Slot*> allocateArrays(std::size_t cap) {
+        if (cap > (SIZE_MAX / sizeof(Slot))) throw std::length_error("RobinHoodHashTable: capacity overflow");
+        std::vector<std::uint8_t> d(cap, 0);
+        Slot* s = std::allocator<Slot>().allocate(cap);
+        return {std::move(d), s};
+    }
+
+    void release() {
+        if (!slots) return;
+        for (std::size_t i = 0; i < dist.size(); ++i) if (dist[i]) slots[i].~Slot();
+        std::allocator<Slot>().deallocate(slots, dist.size());
+        slots = nullptr;
+    }
+
+    std::size_t findIndex(const K& k) const {
+        std::size_t i = home(k);
+        for (unsigned d = 1; ; ++d, i = (i + 1) & mask) {
+            // Early exit: an element with distance >= d would have been placed here.
+            if (dist[i] < d) return SIZE_MAX;
+            if (dist[i] == d && eq(slots[i].first, k)) return i;
+        }
+    }
+
+    // Replays place() on distances only: true if placing an element whose
+    // home is i would keep every displaced element within MAX_DIST.
+    bool fits(std::size_t i) const {
+        for (unsigned d = 1; ; ++d, i = (i + 1) & mask) {
+            if (dist[i] == 0) return true;
+            if (dist[i] < d) d = dist[i];
+            if (d == MAX_DIST) return false;
+        }
+    }
+
+    // Places an element known to be absent; fits() must hold for it.
+    void place(Slot& s) {
+        std::size_t i = home(s.first);
+        std::uint8_t d = 1;
+        while (true) {
+            if (dist[i] == 0) {
+                new (&slots[i]) Slot(std::move(s));
+                dist[i] = d;
+                return;
+            }
+            if (dist[i] < d) {
+                std::swap(slots[i], s);
+                std::swap(dist[i], d);
+            }
+            ++d;
+            i = (i + 1) & mask;
+        }
+    }
+
+    void rehash(std::size_t newCap) {
+        auto fresh = allocateArrays(newCap);   // if this throws, the table is unchanged
+        std::vector<std::uint8_t> oldDist = std::exchange(dist, std::move(fresh.first));
+        Slot* oldSlots = std::exchange(slots, fresh.second);
+        mask = newCap - 1;
+        for (std::size_t i = 0; i < oldDist.size(); ++i) {
+            if (!oldDist[i]) continue;
+            Slot s(std::move(oldSlots[i]));
+            oldSlots[i].~Slot();
+            placeOrGrow(s);
+        }
+        if (oldSlots) std::allocator<Slot>().deallocate(oldSlots, oldDist.size());
+    }
+
+    void placeOrGrow(Slot& s) {
+        while (!fits(home(s.first))) {
+            if (capacity() / SPARSE_LIMIT > count) throw std::length_error("RobinHoodHashTable: probe too long (degenerate hash)");
+            rehash(capacity() * 2);
+        }
+        place(s);
+    }
+
+public:
+    explicit RobinHoodHashTable(std::size_t cap = 16, double maxLoadFactor = 0.9) : maxLoad(maxLoadFactor) {
+        std::size_t c = 16;
+        while (c < cap) c <<= 1;
+        auto fresh = allocateArrays(c);
+        dist = std::move(fresh.first);
+        slots = fresh.second;
+        mask = c - 1;
+    }
+    ~RobinHoodHashTable() { release(); }
+    RobinHoodHashTable(const RobinHoodHashTable&) = delete;
+    RobinHoodHashTable& operator=(const RobinHoodHashTable&) = delete;
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return mask + 1; }
+    double load_factor() const { return static_cast<double>(count) / static_cast<double>(capacity()); }
+
+    bool insert(const K& k, V v) {
+        if (findIndex(k) != SIZE_MAX) return false;
+        if (static_cast<double>(count + 1) > maxLoad * static_cast<double>(capacity())) rehash(capacity() * 2);
+        Slot s(k, std::move(v));
+        placeOrGrow(s);
+        ++count;
+        return true;
+    }
+
+    V* find(const K& k) {
+        std::size_t i = findIndex(k);
+        return i == SIZE_MAX ? nullptr : &slots[i].second;
+    }
+    bool contains(const K& k) const { return findIndex(k) != SIZE_MAX; }
+
+    // Backward-shift deletion: move each following element one slot closer to
+    // home until we reach an empty slot or an element already at home.
+    bool erase(const K& k) {
+        std::size_t i = findIndex(k);
+        if (i == SIZE_MAX) return false;
+        slots[i].~Slot();
+        std::size_t next = (i + 1) & mask;
+        while (dist[next] > 1) {
+            new (&slots[i]) Slot(std::move(slots[next]));
+            slots[next].~Slot();
+            dist[i] = static_cast<std::uint8_t>(dist[next] - 1);
+            i = next;
+            next = (next + 1) & mask;
+        }
+        dist[i] = 0;
+        --count;
+        return true;
+    }
+
+    // histogram[d] = number of elements found after probing d + 1 slots.
+    std::vector<std::size_t> probeHistogram() const {
+        std::vector<std::size_t> hist;
+        for (std::uint8_t d : dist) {
+            if (!d) continue;
+            if (hist.size() < d) hist.resize(d, 0);
+            ++hist[d - 1];
+        }
+        return hist;
+    }
+};
+
+static std::uint64_t splitmix64(std::uint64_t& s) {
+    std::uint64_t z = (s += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Fills a fixed-capacity table to the requested load factor and reports probe
+// lengths plus hit/miss lookup cost.
+static void benchmark(std::size_t capacity, double load) {
+    std::size_t n = static_cast<std::size_t>(static_cast<double>(capacity) * load);
+    RobinHoodHashTable<std::uint64_t, std::uint64_t> ht(capacity, load);
+    std::vector<std::uint64_t> keys(n), misses(n);
+    std::uint64_t seed = 7;
+    for (auto& k : keys) { k = splitmix64(seed); ht.insert(k, k); }
+    for (auto& k : misses) k = splitmix64(seed);
+
+    std::size_t sink = 0;
+    double hit = timeMs([&] { for (auto k : keys) sink += *ht.find(k); });
+    double miss = timeMs([&] { for (auto k : misses) sink += ht.contains(k); });
+
+    auto hist = ht.probeHistogram();
+    double mean = 0;
+    for (std::size_t d = 0; d < hist.size(); ++d) mean += static_cast<double>((d + 1) * hist[d]);
+    mean /= static_cast<double>(n);
+
+    std::cout << "load=" << ht.load_factor() << " n=" << n
+              << "  mean probe=" << mean << " max probe=" << hist.size()
+              << "  hit " << hit * 1e6 / static_cast<double>(n) << " ns"
+              << "  miss " << miss * 1e6 / static_cast<double>(n) << " ns"
+              << "  (sink " << sink % 10 << ")\n  histogram:";
+    std::size_t tail = 0;
+    for (std::size_t d = 0; d < hist.size(); ++d) {
+        if (d < 16) std::cout << ' ' << d + 1 << ':' << hist[d];
+        else tail += hist[d];
+    }
+    if (tail) std::cout << " >16:" << tail;
+    std::cout << '\n';
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Robin Hood HashTable ===\n";
+    RobinHoodHashTable<std::string, int> ht;
+    ht.insert("alpha", 1); ht.insert("beta", 2); ht.insert("gamma", 3);
+    std::cout << "beta -> " << *ht.find("beta") << '\n';
+    ht.erase("beta");
+    std::cout << "Contains beta after erase? " << ht.contains("beta") << '\n';
+
+    std::size_t capacity = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+    for (double load : {0.5, 0.75, 0.9, 0.95}) benchmark(capacity, load);
+    return 0;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 RobinHoodHashTable.cpp -o RobinHoodHashTable */
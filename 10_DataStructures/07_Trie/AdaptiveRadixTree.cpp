@@ -0,0 +1,694 @@
+/**
+ * @file AdaptiveRadixTree.cpp
+ * @brief Adaptive radix tree (Leis et al., ICDE 2013) over arbitrary byte strings.
+ * @date 2026-10-17
+ *
+ * TrieNode in TrieImplementation.cpp always holds 26 child pointers (216 bytes
+ * per node, even with one child) and skips every byte outside 'a'..'z'. ART
+ * keys on full bytes and sizes each inner node to its fan-out:
+ *
+ *   Node4    4 sorted key bytes + 4 children
+ *   Node16   16 sorted key bytes + 16 children, searched with one SSE2 compare
+ *   Node48   256-entry byte -> slot index + 48 children
+ *   Node256  256 children, indexed directly
+ *
+ * Nodes grow to the next size when full and shrink (with some hysteresis)
+ * after erases. Two more tricks keep the tree shallow:
+ * - Lazy expansion: a subtree holding a single key is just its leaf, which
+ *   stores the whole key; inner nodes are created only where keys diverge.
+ * - Path compression: bytes shared by all keys below an inner node are kept in
+ *   the node. Up to MAX_PREFIX bytes are stored inline; longer prefixes are
+ *   skipped optimistically on lookup (the final leaf compare verifies them)
+ *   and recovered from a leaf of the subtree when an insert has to split them.
+ *
+ * A key may be a prefix of another key ("a", "ab"), so every inner node also
+ * has a terminal slot for the leaf whose key ends exactly there. Iteration
+ * visits the terminal leaf first and then the children by byte, which yields
+ * keys in lexicographic (memcmp) order.
+ */
+
+#include <iostream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <new>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Live heap bytes, so the benchmark can compare real footprints. Containers
+// (and this tree) release memory through sized delete, which reports the size.
+static std::size_t liveBytes = 0;
+
+void* operator new(std::size_t size) {
+    liveBytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t size) noexcept { liveBytes -= size; std::free(p); }
+
+template<class V>
+class AdaptiveRadixTree {
+    enum class Type : std::uint8_t { Leaf, N4, N16, N48, N256 };
+    static constexpr std::uint32_t MAX_PREFIX = 10;
+
+    struct Node {
+        Type type;
+        explicit Node(Type t) : type(t) {}
+    };
+    // The key bytes follow the struct in the same allocation.
+    struct Leaf : Node {
+        std::uint32_t keyLen;
+        V value;
+        Leaf(std::uint32_t len, V v) : Node(Type::Leaf), keyLen(len), value(std::move(v)) {}
+        const unsigned char* key() const { return reinterpret_cast<const unsigned char*>(this + 1); }
+        std::string_view view() const { return {reinterpret_cast<const char*>(key()), keyLen}; }
+    };
+    struct Inner : Node {
+        std::uint16_t count = 0;
+        std::uint32_t prefixLen = 0;
+        unsigned char prefix[MAX_PREFIX];
+        Leaf* terminal = nullptr;   // key ending right after the prefix
+        explicit Inner(Type t) : Node(t) {}
+    };
+    struct Node4 : Inner {
+        unsigned char keys[4];
+        Node* children[4];
+        Node4() : Inner(Type::N4) {}
+    };
+    struct Node16 : Inner {
+        unsigned char keys[16];
+        Node* children[16];
+        Node16() : Inner(Type::N16) {}
+    };
+    struct Node48 : Inner {
+        unsigned char index[256] = {};   // 0 = no child, else slot + 1
+        Node* children[48] = {};
+        Node48() : Inner(Type::N48) {}
+    };
+    struct Node256 : Inner {
+        Node* children[256] = {};
+        Node256() : Inner(Type::N256) {}
+    };
+
+    Node* root = nullptr;
+    std::size_t count = 0;
+    std::size_t nodes[5] = {};
+
+    static unsigned char byteAt(std::string_view key, std::size_t i) { return static_cast<unsigned char>(key[i]); }
+
+    // --- allocation ---------------------------------------------------------
+
+    Leaf* makeLeaf(std::string_view key, V value) {
+        void* mem = ::operator new(sizeof(Leaf) + key.size());
+        Leaf* leaf = new (mem) Leaf(static_cast<std::uint32_t>(key.size()), std::move(value));
+        std::memcpy(leaf + 1, key.data(), key.size());
+        ++nodes[0];
+        return leaf;
+    }
+    template<class N> N* make() { N* n = new N(); ++nodes[static_cast<int>(n->type)]; return n; }
+
+    void destroy(Node* n) {
+        if (!n) return;
+        --nodes[static_cast<int>(n->type)];
+        switch (n->type) {
+        case Type::Leaf: { Leaf* l = static_cast<Leaf*>(n); std::size_t bytes = sizeof(Leaf) + l->keyLen; l->~Leaf(); ::operator delete(l, bytes); return; }
+        case Type::N4: { auto* x = static_cast<Node4*>(n); for (unsigned i = 0; i < x->count; ++i) destroy(x->children[i]); destroy(x->terminal); delete x; return; }
+        case Type::N16: { auto* x = static_cast<Node16*>(n); for (unsigned i = 0; i < x->count; ++i) destroy(x->children[i]); destroy(x->terminal); delete x; return; }
+        case Type::N48: { auto* x = static_cast<Node48*>(n); for (Node* c : x->children) destroy(c); destroy(x->terminal); delete x; return; }
+        case Type::N256: { auto* x = static_cast<Node256*>(n); for (Node* c : x->children) destroy(c); destroy(x->terminal); delete x; return; }
+        }
+    }
+    template<class N> void freeInner(N* n) { --nodes[static_cast<int>(n->type)]; delete n; }
+
+    static void copyHeader(Inner* dst, const Inner* src) {
+        dst->count = src->count;
+        dst->prefixLen = src->prefixLen;
+        std::memcpy(dst->prefix, src->prefix, MAX_PREFIX);
+        dst->terminal = src->terminal;
+    }
+
+    // --- child lookup -------------------------------------------------------
+
+    // Index of the first of n->count sorted keys that is >= c, or of c itself.
+    static unsigned lowerBound16(const Node16* n, unsigned char c) {
+#if defined(__SSE2__)
+        const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));   // unsigned compare via signed
+        __m128i keys = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys)), bias);
+        __m128i less = _mm_cmplt_epi8(keys, _mm_xor_si128(_mm_set1_epi8(static_cast<char>(c)), bias));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(less)) & ((1u << n->count) - 1);
+        return static_cast<unsigned>(__builtin_popcount(mask));
+#else
+        unsigned i = 0;
+        while (i < n->count && n->keys[i] < c) ++i;
+        return i;
+#endif
+    }
+
+    static Node** findChild(Inner* n, unsigned char c) {
+        switch (n->type) {
+        case Type::N4: {
+            auto* x = static_cast<Node4*>(n);
+            for (unsigned i = 0; i < x->count; ++i) if (x->keys[i] == c) return &x->children[i];
+            return nullptr;
+        }
+        case Type::N16: {
+            auto* x = static_cast<Node16*>(n);
+#if defined(__SSE2__)
+            __m128i eq = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(c)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(x->keys)));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(eq)) & ((1u << x->count) - 1);
+            return mask ? &x->children[__builtin_ctz(mask)] : nullptr;
+#else
+            for (unsigned i = 0; i < x->count; ++i) if (x->keys[i] == c) return &x->children[i];
+            return nullptr;
+#endif
+        }
+        case Type::N48: {
+            auto* x = static_cast<Node48*>(n);
+            return x->index[c] ? &x->children[x->index[c] - 1] : nullptr;
+        }
+        case Type::N256: {
+            auto* x = static_cast<Node256*>(n);
+            return x->children[c] ? &x->children[c] : nullptr;
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    // Leftmost leaf below n; every leaf there shares n's full compressed prefix.
+    static const Leaf* minimum(const Node* n) {
+        for (;;) {
+            if (n->type == Type::Leaf) return static_cast<const Leaf*>(n);
+            const Inner* in = static_cast<const Inner*>(n);
+            if (in->terminal) return in->terminal;
+            switch (n->type) {
+            case Type::N4: n = static_cast<const Node4*>(n)->children[0]; break;
+            case Type::N16: n = static_cast<const Node16*>(n)->children[0]; break;
+            case Type::N48: {
+                auto* x = static_cast<const Node48*>(n);
+                unsigned c = 0;
+                while (!x->index[c]) ++c;
+                n = x->children[x->index[c] - 1];
+                break;
+            }
+            default: {
+                auto* x = static_cast<const Node256*>(n);
+                unsigned c = 0;
+                while (!x->children[c]) ++c;
+                n = x->children[c];
+            }
+            }
+        }
+    }
+
+    // Number of leading bytes of n's prefix that match key[depth..].
+    static std::uint32_t prefixMismatch(const Inner* n, std::string_view key, std::size_t depth) {
+        std::uint32_t stored = std::min(n->prefixLen, MAX_PREFIX), i = 0;
+        for (; i < stored; ++i)
+            if (depth + i >= key.size() || n->prefix[i] != byteAt(key, depth + i)) return i;
+        if (n->prefixLen > MAX_PREFIX) {
+            const unsigned char* full = minimum(n)->key();
+            for (; i < n->prefixLen; ++i)
+                if (depth + i >= key.size() || full[depth + i] != byteAt(key, depth + i)) return i;
+        }
+        return i;
+    }
+
+    // --- growing and shrinking ---------------------------------------------
+
+    // Adds child under byte c; ref is replaced if the node has to grow.
+    void addChild(Node*& ref, Inner* n, unsigned char c, Node* child) {
+        switch (n->type) {
+        case Type::N4: {
+            auto* x = static_cast<Node4*>(n);
+            if (x->count < 4) {
+                unsigned i = 0;
+                while (i < x->count && x->keys[i] < c) ++i;
+                std::memmove(x->keys + i + 1, x->keys + i, x->count - i);
+                std::memmove(x->children + i + 1, x->children + i, (x->count - i) * sizeof(Node*));
+                x->keys[i] = c; x->children[i] = child; ++x->count;
+                return;
+            }
+            auto* g = make<Node16>();
+            copyHeader(g, x);
+            std::memcpy(g->keys, x->keys, 4);
+            std::memcpy(g->children, x->children, 4 * sizeof(Node*));
+            freeInner(x);
+            ref = g;
+            addChild(ref, g, c, child);
+            return;
+        }
+        case Type::N16: {
+            auto* x = static_cast<Node16*>(n);
+            if (x->count < 16) {
+                unsigned i = lowerBound16(x, c);
+                std::memmove(x->keys + i + 1, x->keys + i, x->count - i);
+                std::memmove(x->children + i + 1, x->children + i, (x->count - i) * sizeof(Node*));
+                x->keys[i] = c; x->children[i] = child; ++x->count;
+                return;
+            }
+            auto* g = make<Node48>();
+            copyHeader(g, x);
+            for (unsigned i = 0; i < 16; ++i) { g->children[i] = x->children[i]; g->index[x->keys[i]] = static_cast<unsigned char>(i + 1); }
+            freeInner(x);
+            ref = g;
+            addChild(ref, g, c, child);
+            return;
+        }
+        case Type::N48: {
+            auto* x = static_cast<Node48*>(n);
+            if (x->count < 48) {
+                unsigned slot = 0;
+                while (x->children[slot]) ++slot;   // erases can leave holes
+                x->children[slot] = child;
+                x->index[c] = static_cast<unsigned char>(slot + 1);
+                ++x->count;
+                return;
+            }
+            auto* g = make<Node256>();
+            copyHeader(g, x);
+            for (unsigned b = 0; b < 256; ++b) if (x->index[b]) g->children[b] = x->children[x->index[b] - 1];
+            freeInner(x);
+            ref = g;
+            addChild(ref, g, c, child);
+            return;
+        }
+        default: {
+            auto* x = static_cast<Node256*>(n);
+            x->children[c] = child;
+            ++x->count;
+        }
+        }
+    }
+
+    void removeChild(Inner* n, unsigned char c) {
+        switch (n->type) {
+        case Type::N4:
+        case Type::N16: {
+            unsigned char* keys = n->type == Type::N4 ? static_cast<Node4*>(n)->keys : static_cast<Node16*>(n)->keys;
+            Node** children = n->type == Type::N4 ? static_cast<Node4*>(n)->children : static_cast<Node16*>(n)->children;
+            unsigned i = 0;
+            while (keys[i] != c) ++i;
+            std::memmove(keys + i, keys + i + 1, n->count - i - 1);
+            std::memmove(children + i, children + i + 1, (n->count - i - 1) * sizeof(Node*));
+            break;
+        }
+        case Type::N48: {
+            auto* x = static_cast<Node48*>(n);
+            x->children[x->index[c] - 1] = nullptr;
+            x->index[c] = 0;
+            break;
+        }
+        default:
+            static_cast<Node256*>(n)->children[c] = nullptr;
+        }
+        --n->count;
+    }
+
+    // Replaces n by a smaller node (or by its only leaf/child) when sparse enough.
+    void shrink(Node*& ref, Inner* n) {
+        switch (n->type) {
+        case Type::N4: {
+            auto* x = static_cast<Node4*>(n);
+            if (x->count == 0) { ref = x->terminal; freeInner(x); return; }   // a terminal must remain
+            if (x->count != 1 || x->terminal) return;
+            Node* child = x->children[0];
+            if (child->type != Type::Leaf) {
+                // Merge: our prefix + the edge byte + the child's prefix.
+                auto* in = static_cast<Inner*>(child);
+                unsigned char merged[MAX_PREFIX];
+                std::uint32_t len = std::min(x->prefixLen, MAX_PREFIX);
+                std::memcpy(merged, x->prefix, len);
+                if (len < MAX_PREFIX) merged[len++] = x->keys[0];
+                std::uint32_t take = std::min(in->prefixLen, MAX_PREFIX - len);
+                std::memcpy(merged + len, in->prefix, take);
+                std::memcpy(in->prefix, merged, len + take);
+                in->prefixLen += x->prefixLen + 1;
+            }
+            ref = child;
+            freeInner(x);
+            return;
+        }
+        case Type::N16: {
+            auto* x = static_cast<Node16*>(n);
+            if (x->count > 3) return;
+            auto* s = make<Node4>();
+            copyHeader(s, x);
+            std::memcpy(s->keys, x->keys, x->count);
+            std::memcpy(s->children, x->children, x->count * sizeof(Node*));
+            freeInner(x);
+            ref = s;
+            return;
+        }
+        case Type::N48: {
+            auto* x = static_cast<Node48*>(n);
+            if (x->count > 12) return;
+            auto* s = make<Node16>();
+            copyHeader(s, x);
+            unsigned i = 0;
+            for (unsigned b = 0; b < 256; ++b)
+                if (x->index[b]) { s->keys[i] = static_cast<unsigned char>(b); s->children[i++] = x->children[x->index[b] - 1]; }
+            freeInner(x);
+            ref = s;
+            return;
+        }
+        default: {
+            auto* x = static_cast<Node256*>(n);
+            if (x->count > 37) return;
+            auto* s = make<Node48>();
+            copyHeader(s, x);
+            unsigned slot = 0;
+            for (unsigned b = 0; b < 256; ++b)
+                if (x->children[b]) { s->children[slot] = x->children[b]; s->index[b] = static_cast<unsigned char>(++slot); }
+            freeInner(x);
+            ref = s;
+        }
+        }
+    }
+
+    // --- recursive insert / erase -------------------------------------------
+
+    bool insert(Node*& ref, std::string_view key, std::size_t depth, V& value) {
+        if (!ref) { ref = makeLeaf(key, std::move(value)); return true; }
+
+        if (ref->type == Type::Leaf) {
+            Leaf* leaf = static_cast<Leaf*>(ref);
+            if (leaf->view() == key) { leaf->value = std::move(value); return false; }
+            // Lazy expansion ends here: split into a Node4 at the first differing byte.
+            std::size_t lcp = 0;
+            while (depth + lcp < key.size() && depth + lcp < leaf->keyLen && leaf->key()[depth + lcp] == byteAt(key, depth + lcp)) ++lcp;
+            auto* n = make<Node4>();
+            n->prefixLen = static_cast<std::uint32_t>(lcp);
+            std::memcpy(n->prefix, key.data() + depth, std::min<std::size_t>(lcp, MAX_PREFIX));
+            std::size_t d = depth + lcp;
+            Node* self = n;
+            if (leaf->keyLen == d) n->terminal = leaf; else addChild(self, n, leaf->key()[d], leaf);
+            Leaf* fresh = makeLeaf(key, std::move(value));
+            if (key.size() == d) n->terminal = fresh; else addChild(self, n, byteAt(key, d), fresh);
+            ref = self;
+            return true;
+        }
+
+        Inner* n = static_cast<Inner*>(ref);
+        if (n->prefixLen) {
+            std::uint32_t mismatch = prefixMismatch(n, key, depth);
+            if (mismatch < n->prefixLen) {
+                // Split the compressed path: a new Node4 takes the common part.
+                auto* top = make<Node4>();
+                top->prefixLen = mismatch;
+                std::memcpy(top->prefix, n->prefix, std::min(mismatch, MAX_PREFIX));
+                unsigned char edge;
+                std::uint32_t rest = n->prefixLen - mismatch - 1;
+                if (n->prefixLen <= MAX_PREFIX) {
+                    edge = n->prefix[mismatch];
+                    std::memmove(n->prefix, n->prefix + mismatch + 1, rest);
+                } else {
+                    const unsigned char* full = minimum(n)->key();
+                    edge = full[depth + mismatch];
+                    std::memcpy(n->prefix, full + depth + mismatch + 1, std::min(rest, MAX_PREFIX));
+                }
+                n->prefixLen = rest;
+                Node* self = top;
+                addChild(self, top, edge, n);
+                Leaf* fresh = makeLeaf(key, std::move(value));
+                if (key.size() == depth + mismatch) top->terminal = fresh;
+                else addChild(self, top, byteAt(key, depth + mismatch), fresh);
+                ref = self;
+                return true;
+            }
+            depth += n->prefixLen;
+        }
+        if (depth == key.size()) {
+            if (n->terminal) { n->terminal->value = std::move(value); return false; }
+            n->terminal = makeLeaf(key, std::move(value));
+            return true;
+        }
+        if (Node** child = findChild(n, byteAt(key, depth))) return insert(*child, key, depth + 1, value);
+        addChild(ref, n, byteAt(key, depth), makeLeaf(key, std::move(value)));
+        return true;
+    }
+
+    bool erase(Node*& ref, std::string_view key, std::size_t depth) {
+        Inner* n = static_cast<Inner*>(ref);
+        if (n->prefixLen) {
+            if (prefixMismatch(n, key, depth) != n->prefixLen) return false;
+            depth += n->prefixLen;
+        }
+        if (depth == key.size()) {
+            if (!n->terminal) return false;
+            destroy(n->terminal);
+            n->terminal = nullptr;
+            shrink(ref, n);
+            return true;
+        }
+        unsigned char c = byteAt(key, depth);
+        Node** child = findChild(n, c);
+        if (!child) return false;
+        if ((*child)->type == Type::Leaf) {
+            if (static_cast<Leaf*>(*child)->view() != key) return false;
+            destroy(*child);
+            removeChild(n, c);
+            shrink(ref, n);
+            return true;
+        }
+        return erase(*child, key, depth + 1);
+    }
+
+    template<class F>
+    static bool walk(const Node* n, F& fn) {
+        if (n->type == Type::Leaf) { auto* l = static_cast<const Leaf*>(n); return fn(l->view(), l->value); }
+        const Inner* in = static_cast<const Inner*>(n);
+        if (in->terminal && !fn(in->terminal->view(), in->terminal->value)) return false;
+        switch (n->type) {
+        case Type::N4: { auto* x = static_cast<const Node4*>(n); for (unsigned i = 0; i < x->count; ++i) if (!walk(x->children[i], fn)) return false; break; }
+        case Type::N16: { auto* x = static_cast<const Node16*>(n); for (unsigned i = 0; i < x->count; ++i) if (!walk(x->children[i], fn)) return false; break; }
+        case Type::N48: { auto* x = static_cast<const Node48*>(n); for (unsigned b = 0; b < 256; ++b) if (x->index[b] && !walk(x->children[x->index[b] - 1], fn)) return false; break; }
+        default: { auto* x = static_cast<const Node256*>(n); for (const Node* c : x->children) if (c && !walk(c, fn)) return false; }
+        }
+        return true;
+    }
+
+public:
+    AdaptiveRadixTree() = default;
+    AdaptiveRadixTree(const AdaptiveRadixTree&) = delete;
+    AdaptiveRadixTree& operator=(const AdaptiveRadixTree&) = delete;
+    ~AdaptiveRadixTree() { destroy(root); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Inserts or overwrites; returns true if the key was new.
+    bool insert(std::string_view key, V value) {
+        bool added = insert(root, key, 0, value);
+        count += added;
+        return added;
+    }
+
+    const V* find(std::string_view key) const {
+        const Node* n = root;
+        std::size_t depth = 0;
+        while (n) {
+            if (n->type == Type::Leaf) {
+                const Leaf* l = static_cast<const Leaf*>(n);
+                return l->view() == key ? &l->value : nullptr;
+            }
+            const Inner* in = static_cast<const Inner*>(n);
+            // Optimistic: only the stored prefix bytes are compared; the leaf check covers the rest.
+            std::uint32_t stored = std::min(in->prefixLen, MAX_PREFIX);
+            if (depth + in->prefixLen > key.size() || std::memcmp(in->prefix, key.data() + depth, stored) != 0) return nullptr;
+            depth += in->prefixLen;
+            if (depth == key.size()) return in->terminal && in->terminal->view() == key ? &in->terminal->value : nullptr;
+            Node* const* child = findChild(const_cast<Inner*>(in), byteAt(key, depth));
+            n = child ? *child : nullptr;
+            ++depth;
+        }
+        return nullptr;
+    }
+    V* find(std::string_view key) { return const_cast<V*>(static_cast<const AdaptiveRadixTree*>(this)->find(key)); }
+    bool contains(std::string_view key) const { return find(key) != nullptr; }
+
+    bool erase(std::string_view key) {
+        if (!root) return false;
+        bool removed;
+        if (root->type == Type::Leaf) {
+            removed = static_cast<Leaf*>(root)->view() == key;
+            if (removed) { destroy(root); root = nullptr; }
+        } else {
+            removed = erase(root, key, 0);
+        }
+        count -= removed;
+        return removed;
+    }
+
+    // Calls fn(std::string_view key, const V& value) in lexicographic key
+    // order; fn returns false to stop early.
+    template<class F>
+    void forEach(F fn) const { if (root) walk(root, fn); }
+
+    // Like forEach, restricted to keys starting with prefix.
+    template<class F>
+    void scanPrefix(std::string_view prefix, F fn) const {
+        const Node* n = root;
+        std::size_t depth = 0;
+        while (n && n->type != Type::Leaf) {
+            const Inner* in = static_cast<const Inner*>(n);
+            if (depth + in->prefixLen >= prefix.size()) break;   // prefix ends inside this node's path
+            depth += in->prefixLen;
+            Node* const* child = findChild(const_cast<Inner*>(in), byteAt(prefix, depth));
+            n = child ? *child : nullptr;
+            ++depth;
+        }
+        if (!n) return;
+        // All leaves below n share their first depth + prefixLen bytes, so one
+        // leaf tells whether the whole subtree matches.
+        std::string_view k = minimum(n)->view();
+        if (k.substr(0, prefix.size()) == prefix) walk(n, fn);
+    }
+
+    // Leaves, Node4, Node16, Node48, Node256.
+    const std::size_t* nodeCounts() const { return nodes; }
+};
+
+// The original TrieNode, for its per-node size.
+struct TrieNode {
+    std::unique_ptr<TrieNode> children[26];
+    bool terminal = false;
+};
+
+// Synthetic URLs: a few thousand hosts, shared path segments, numeric IDs.
+std::vector<std::string> makeUrls(std::size_t n, std::uint64_t seed) {
+    static const char* const segments[] = {"news", "sport", "article", "products", "item", "user", "profile", "blog", "2025",
+                                            "2026", "search", "category", "images", "video", "docs", "api", "v1", "v2"};
+    static const char* const tlds[] = {".com", ".org", ".net", ".de", ".co.uk", ".io"};
+    auto next = [&seed] { seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; return seed; };
+    std::vector<std::string> urls;
+    urls.reserve(n);
+    const std::size_t hosts = std::max<std::size_t>(1, n / 200);
+    while (urls.size() < n) {
+        std::uint64_t r = next();
+        std::string url = (r & 1) ? "https://www." : "http://";
+        std::uint64_t host = (r >> 1) % hosts;
+        url += "site" + std::to_string(host * 2654435761u % 1000003) + tlds[host % 6];
+        for (std::uint64_t depth = 1 + (r >> 20) % 3; depth > 0; --depth) { url += '/'; url += segments[next() % 18]; }
+        url += '/' + std::to_string(next() % 10000000);
+        if ((r >> 40) % 4 == 0) url += "?ref=" + std::to_string(next() % 100);
+        urls.push_back(std::move(url));
+    }
+    std::sort(urls.begin(), urls.end());
+    urls.erase(std::unique(urls.begin(), urls.end()), urls.end());
+    for (std::size_t i = urls.size(); i > 1; --i) std::swap(urls[i - 1], urls[next() % i]);
+    return urls;
+}
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Adaptive radix tree ===\n";
+    {
+        AdaptiveRadixTree<int> t;
+        for (const char* w : {"hello", "help", "he", "Hello World", "caf\xc3\xa9", "zebra", "help"}) t.insert(w, static_cast<int>(std::strlen(w)));
+        std::cout << "size=" << t.size() << " contains(\"he\")=" << t.contains("he") << " contains(\"hel\")=" << t.contains("hel")
+                  << " contains(\"Hello World\")=" << t.contains("Hello World") << "\nin order:";
+        t.forEach([](std::string_view k, int v) { std::cout << " [" << k << "]=" << v; return true; });
+        std::cout << "\nprefix \"hel\":";
+        t.scanPrefix("hel", [](std::string_view k, int) { std::cout << ' ' << k; return true; });
+        t.erase("help");
+        std::cout << "\nafter erase(\"help\"): contains(\"help\")=" << t.contains("help") << " contains(\"hello\")=" << t.contains("hello") << "\n\n";
+    }
+
+    // Usage: ./AdaptiveRadixTree [keys]
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::vector<std::string> urls = makeUrls(n, 0x9e3779b97f4a7c15ULL);
+    std::size_t keyBytes = 0;
+    for (auto& u : urls) keyBytes += u.size();
+    std::cout << urls.size() << " unique URLs, " << keyBytes / 1e6 << " MB of key bytes\n";
+
+    // TrieNode-style trie: one 216-byte node per distinct prefix of the keys.
+    std::vector<std::string> sorted(urls);
+    std::sort(sorted.begin(), sorted.end());
+    std::size_t trieNodes = 1;
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        std::size_t lcp = 0;
+        if (i) while (lcp < sorted[i].size() && lcp < sorted[i - 1].size() && sorted[i][lcp] == sorted[i - 1][lcp]) ++lcp;
+        trieNodes += sorted[i].size() - lcp;
+    }
+    std::vector<std::string>().swap(sorted);
+
+    std::size_t sink = 0;
+    std::size_t before = liveBytes;
+    AdaptiveRadixTree<std::uint32_t> art;
+    double artInsert = timeMs([&] { for (std::size_t i = 0; i < urls.size(); ++i) art.insert(urls[i], static_cast<std::uint32_t>(i)); });
+    std::size_t artBytes = liveBytes - before;
+
+    before = liveBytes;
+    std::map<std::string, std::uint32_t> ordered;
+    double mapInsert = timeMs([&] { for (std::size_t i = 0; i < urls.size(); ++i) ordered.emplace(urls[i], static_cast<std::uint32_t>(i)); });
+    std::size_t mapBytes = liveBytes - before;
+
+    before = liveBytes;
+    std::unordered_map<std::string, std::uint32_t> hashed;
+    double hashInsert = timeMs([&] { for (std::size_t i = 0; i < urls.size(); ++i) hashed.emplace(urls[i], static_cast<std::uint32_t>(i)); });
+    std::size_t hashBytes = liveBytes - before;
+
+    std::vector<std::string> probes(urls.rbegin(), urls.rend());
+    double artFind = timeMs([&] { for (auto& k : probes) sink += *art.find(k); });
+    double mapFind = timeMs([&] { for (auto& k : probes) sink += ordered.find(k)->second; });
+    double hashFind = timeMs([&] { for (auto& k : probes) sink += hashed.find(k)->second; });
+
+    std::string last;
+    bool sortedOk = true;
+    std::size_t visited = 0;
+    double artIter = timeMs([&] {
+        art.forEach([&](std::string_view k, std::uint32_t) { sortedOk &= last < k || visited == 0; last.assign(k); ++visited; return true; });
+    });
+    double mapIter = timeMs([&] { for (auto& kv : ordered) sink += kv.second; });
+
+    // Prefix scan: every URL of 1000 hosts.
+    std::vector<std::string> hostPrefixes;
+    for (std::size_t i = 0; i < 1000 && i < urls.size(); ++i) hostPrefixes.push_back(urls[i].substr(0, urls[i].find('/', 8) + 1));
+    std::size_t artHits = 0, mapHits = 0;
+    double artScan = timeMs([&] { for (auto& p : hostPrefixes) art.scanPrefix(p, [&](std::string_view, std::uint32_t) { ++artHits; return true; }); });
+    double mapScan = timeMs([&] {
+        for (auto& p : hostPrefixes)
+            for (auto it = ordered.lower_bound(p); it != ordered.end() && it->first.compare(0, p.size(), p) == 0; ++it) ++mapHits;
+    });
+
+    const std::size_t* nc = art.nodeCounts();
+    std::cout << "ART nodes: " << nc[0] << " leaves, N4=" << nc[1] << " N16=" << nc[2] << " N48=" << nc[3] << " N256=" << nc[4] << "\n"
+              << "                       ART      std::map  unordered_map\n"
+              << "bytes/key          " << static_cast<double>(artBytes) / urls.size() << "\t" << static_cast<double>(mapBytes) / urls.size()
+              << "\t" << static_cast<double>(hashBytes) / urls.size() << "\n"
+              << "insert (ns/key)    " << artInsert * 1e6 / urls.size() << "\t" << mapInsert * 1e6 / urls.size() << "\t" << hashInsert * 1e6 / urls.size() << "\n"
+              << "find (ns/key)      " << artFind * 1e6 / urls.size() << "\t" << mapFind * 1e6 / urls.size() << "\t" << hashFind * 1e6 / urls.size() << "\n"
+              << "ordered scan (ms)  " << artIter << "\t" << mapIter << "\t-\n"
+              << "1000 prefix scans  " << artScan << " ms\t" << mapScan << " ms  (" << artHits << " / " << mapHits << " keys)\n"
+              << "TrieNode layout (estimated): " << trieNodes << " nodes, "
+              << static_cast<double>(trieNodes * sizeof(TrieNode)) / urls.size() << " bytes/key\n"
+              << "ordered=" << (sortedOk && visited == urls.size()) << " (sink " << sink % 10 << ")\n";
+
+    // Erase everything to exercise shrinking; the tree must end up empty.
+    for (std::size_t i = 0; i < urls.size(); i += 2) art.erase(urls[i]);
+    bool ok = art.size() == urls.size() / 2;
+    for (std::size_t i = 0; i < urls.size(); ++i) ok &= art.contains(urls[i]) == (i % 2 == 1);
+    for (std::size_t i = 1; i < urls.size(); i += 2) art.erase(urls[i]);
+    std::cout << "erase check: " << (ok && art.empty() && art.nodeCounts()[0] == 0 ? "ok" : "FAILED") << "\n";
+    return ok && sortedOk && artHits == mapHits ? 0 : 1;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 AdaptiveRadixTree.cpp -o AdaptiveRadixTree */
@@ -0,0 +1,335 @@
+/**
+ * @file Autocomplete.cpp
+ * @brief Top-K weighted autocomplete: a trie annotated with subtree maxima and
+ *        a best-first search bounded by k.
+ * @date 2026-10-17
+ *
+ * Trie only answers exact contains(). For a search box we need
+ * complete(prefix, k): the k highest-weighted terms starting with prefix.
+ * Collecting every completion and sorting costs the size of the subtree, which
+ * for a one-letter prefix is a large part of the dictionary. Instead:
+ *
+ * - Every node stores maxWeight, the largest weight in its subtree, and its
+ *   children are kept in a sibling list sorted by maxWeight (descending).
+ * - complete() runs a best-first search from the prefix node. A frontier
+ *   entry is either a node (priority = maxWeight) or a finished term
+ *   (priority = weight). Expanding a node pushes its own term, its first child
+ *   and, because siblings are sorted, only the next sibling of the child just
+ *   popped. Each pop therefore pushes at most three entries.
+ * - Every node entry stands for a disjoint subtree that contains a term of
+ *   exactly its priority, so once the frontier holds more entries than results
+ *   still needed, the lowest can never reach the top k: the frontier is a
+ *   BoundedQueue of capacity k - found.
+ * Each result is reached after at most depth expansions, so a query touches
+ * O(k * depth) nodes regardless of how many terms share the prefix.
+ *
+ * complete_many() answers a batch of prefixes in parallel; queries only read
+ * the trie, so threads share it without locking.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <unordered_set>
+
+// Fixed-capacity max-queue that silently drops its smallest entries.
+template<class T>
+class BoundedQueue {
+    std::vector<T> items;   // ascending, so the maximum is at the back
+    std::size_t capacity = 0;
+public:
+    void reset(std::size_t cap) { items.clear(); capacity = cap; }
+    void shrinkTo(std::size_t cap) {
+        capacity = cap;
+        if (items.size() > cap) items.erase(items.begin(), items.end() - static_cast<std::ptrdiff_t>(cap));
+    }
+    void push(const T& x) {
+        if (capacity == 0 || (items.size() == capacity && !(items.front() < x))) return;
+        items.insert(std::upper_bound(items.begin(), items.end(), x), x);
+        if (items.size() > capacity) items.erase(items.begin());
+    }
+    bool empty() const { return items.empty(); }
+    T pop() { T x = items.back(); items.pop_back(); return x; }
+};
+
+class AutocompleteTrie {
+public:
+    struct Completion {
+        std::string term;
+        std::uint32_t weight;
+    };
+
+private:
+    static constexpr std::uint32_t NONE = static_cast<std::uint32_t>(-1);
+
+    struct Node {
+        std::uint32_t firstChild = NONE;
+        std::uint32_t nextSibling = NONE;   // siblings sorted by maxWeight, descending
+        std::uint32_t parent = NONE;
+        std::uint32_t weight = 0;           // valid if terminal
+        std::uint32_t maxWeight = 0;        // over this node's subtree
+        unsigned char byte = 0;
+        bool terminal = false;
+    };
+
+    struct Entry {
+        std::uint32_t priority;
+        std::uint32_t node;
+        bool term;   // finished term rather than a subtree
+        bool operator<(const Entry& o) const {
+            if (priority != o.priority) return priority < o.priority;
+            if (term != o.term) return !term;   // on ties, emit terms before expanding
+            return node > o.node;
+        }
+    };
+
+    std::vector<Node> nodes{Node{}};
+    std::size_t terms = 0;
+
+    std::uint32_t findChild(std::uint32_t n, unsigned char b) const {
+        for (std::uint32_t c = nodes[n].firstChild; c != NONE; c = nodes[c].nextSibling)
+            if (nodes[c].byte == b) return c;
+        return NONE;
+    }
+
+    // Moves n to its place in the parent's sibling list after maxWeight changed.
+    void reposition(std::uint32_t n) {
+        std::uint32_t p = nodes[n].parent;
+        std::uint32_t* link = &nodes[p].firstChild;
+        while (*link != n) link = &nodes[*link].nextSibling;
+        *link = nodes[n].nextSibling;
+        link = &nodes[p].firstChild;
+        while (*link != NONE && nodes[*link].maxWeight >= nodes[n].maxWeight) link = &nodes[*link].nextSibling;
+        nodes[n].nextSibling = *link;
+        *link = n;
+    }
+
+    std::string spell(std::uint32_t n) const {
+        std::string s;
+        for (; n != 0; n = nodes[n].parent) s.push_back(static_cast<char>(nodes[n].byte));
+        std::reverse(s.begin(), s.end());
+        return s;
+    }
+
+public:
+    std::size_t size() const { return terms; }
+    std::size_t nodeCount() const { return nodes.size(); }
+    std::size_t memoryBytes() const { return nodes.capacity() * sizeof(Node); }
+
+    // Adds term or changes its weight.
+    void insert(std::string_view term, std::uint32_t weight) {
+        std::uint32_t n = 0;
+        for (char ch : term) {
+            unsigned char b = static_cast<unsigned char>(ch);
+            std::uint32_t c = findChild(n, b);
+            if (c == NONE) {
+                c = static_cast<std::uint32_t>(nodes.size());
+                Node fresh;
+                fresh.parent = n;
+                fresh.byte = b;
+                fresh.nextSibling = nodes[n].firstChild;   // maxWeight 0 for now; repositioned below
+                nodes.push_back(fresh);
+                nodes[n].firstChild = c;
+            }
+            n = c;
+        }
+        terms += !nodes[n].terminal;
+        nodes[n].terminal = true;
+        nodes[n].weight = weight;
+        // Recompute maxima bottom-up; the first child holds each node's best subtree.
+        for (;;) {
+            Node& x = nodes[n];
+            x.maxWeight = x.terminal ? x.weight : 0;
+            if (x.firstChild != NONE) x.maxWeight = std::max(x.maxWeight, nodes[x.firstChild].maxWeight);
+            if (n == 0) break;
+            reposition(n);
+            n = nodes[n].parent;
+        }
+    }
+
+    // Top k completions of prefix, by decreasing weight. nodesTouched, if
+    // given, receives the number of frontier pops.
+    std::vector<Completion> complete(std::string_view prefix, std::size_t k, std::size_t* nodesTouched = nullptr) const {
+        thread_local BoundedQueue<Entry> frontier;
+        std::vector<Completion> out;
+        std::uint32_t n = 0;
+        for (char ch : prefix)
+            if ((n = findChild(n, static_cast<unsigned char>(ch))) == NONE) return out;
+
+        std::size_t pops = 0;
+        frontier.reset(k);
+        frontier.push({nodes[n].maxWeight, n, false});
+        while (!frontier.empty() && out.size() < k) {
+            Entry e = frontier.pop();
+            ++pops;
+            if (e.term) {
+                out.push_back({spell(e.node), e.priority});
+                frontier.shrinkTo(k - out.size());
+                continue;
+            }
+            const Node& x = nodes[e.node];
+            if (x.terminal) frontier.push({x.weight, e.node, true});
+            if (x.firstChild != NONE) frontier.push({nodes[x.firstChild].maxWeight, x.firstChild, false});
+            // The entry's later siblings only enter the frontier once it has been expanded.
+            if (e.node != n && x.nextSibling != NONE) frontier.push({nodes[x.nextSibling].maxWeight, x.nextSibling, false});
+        }
+        if (nodesTouched) *nodesTouched += pops;
+        return out;
+    }
+
+    // Answers every prefix, spreading the batch over threads.
+    std::vector<std::vector<Completion>> complete_many(const std::vector<std::string>& prefixes, std::size_t k,
+                                                       unsigned threads = std::thread::hardware_concurrency()) const {
+        std::vector<std::vector<Completion>> results(prefixes.size());
+        threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(prefixes.size() / 64 + 1)));
+        std::vector<std::thread> pool;
+        std::size_t chunk = (prefixes.size() + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; ++t) {
+            std::size_t lo = t * chunk, hi = std::min(prefixes.size(), lo + chunk);
+            if (lo >= hi) break;
+            pool.emplace_back([&, lo, hi] { for (std::size_t i = lo; i < hi; ++i) results[i] = complete(prefixes[i], k); });
+        }
+        for (auto& th : pool) th.join();
+        return results;
+    }
+
+    // Baseline: every completion under the prefix, then a partial sort.
+    std::vector<Completion> completeExhaustive(std::string_view prefix, std::size_t k) const {
+        std::vector<Completion> out;
+        std::uint32_t n = 0;
+        for (char ch : prefix)
+            if ((n = findChild(n, static_cast<unsigned char>(ch))) == NONE) return out;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> found;   // (weight, node)
+        std::vector<std::uint32_t> stack{n};
+        while (!stack.empty()) {
+            std::uint32_t x = stack.back();
+            stack.pop_back();
+            if (nodes[x].terminal) found.emplace_back(nodes[x].weight, x);
+            for (std::uint32_t c = nodes[x].firstChild; c != NONE; c = nodes[c].nextSibling) stack.push_back(c);
+        }
+        std::size_t take = std::min(k, found.size());
+        std::partial_sort(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(take), found.end(),
+                          [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (std::size_t i = 0; i < take; ++i) out.push_back({spell(found[i].second), found[i].first});
+        return out;
+    }
+};
+
+// n distinct multi-word query log terms with Zipf-like weights.
+std::vector<std::pair<std::string, std::uint32_t>> makeDictionary(std::size_t n, std::uint64_t seed) {
+    static const char* const syllables[] = {"an", "ber", "ca", "de", "el", "fo", "gra", "hu", "in", "jo", "ka", "lu", "mi",
+                                            "no", "or", "pa", "qui", "re", "sa", "ti", "un", "ve", "wo", "xi", "yo", "ze"};
+    auto next = [&seed] { seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; return seed; };
+    std::vector<std::string> words;
+    for (std::size_t i = 0; i < 20000; ++i) {
+        std::string w;
+        for (std::uint64_t k = 1 + next() % 3; k > 0; --k) w += syllables[next() % 26];
+        words.push_back(std::move(w));
+    }
+    std::vector<std::pair<std::string, std::uint32_t>> dict;
+    std::unordered_set<std::string> seen;
+    dict.reserve(n);
+    while (dict.size() < n) {
+        std::string term = words[next() % words.size()];
+        for (std::uint64_t extra = next() % 3; extra > 0; --extra) term += ' ' + words[next() % words.size()];
+        if (!seen.insert(term).second) continue;
+        double u = static_cast<double>((next() >> 11) + 1) / 9007199254740992.0;
+        dict.emplace_back(std::move(term), static_cast<std::uint32_t>(1000000.0 / (u * 999.0 + 1.0) / (u * 999.0 + 1.0)));
+    }
+    return dict;
+}
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static double percentile(std::vector<double> v, double p) {
+    std::size_t i = static_cast<std::size_t>(p * static_cast<double>(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(i), v.end());
+    return v[i];
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Top-K autocomplete ===\n";
+    AutocompleteTrie small;
+    for (auto& [t, w] : std::vector<std::pair<std::string, std::uint32_t>>{
+             {"hello", 50}, {"help", 90}, {"helium", 20}, {"hero", 70}, {"her", 10}, {"heat", 40}, {"world", 99}})
+        small.insert(t, w);
+    auto show = [](const std::vector<AutocompleteTrie::Completion>& r) {
+        for (auto& c : r) std::cout << ' ' << c.term << '(' << c.weight << ')';
+        std::cout << '\n';
+    };
+    std::cout << "complete(\"he\", 3):";
+    show(small.complete("he", 3));
+    small.insert("helium", 95);
+    std::cout << "after helium=95:";
+    show(small.complete("he", 3));
+
+    // Usage: ./Autocomplete [terms] [k] [queries] [maxThreads]
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t k = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+    std::size_t numQueries = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200000;
+    unsigned maxThreads = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : std::max(1u, std::thread::hardware_concurrency());
+
+    auto dict = makeDictionary(n, 0x9e3779b97f4a7c15ULL);
+    AutocompleteTrie trie;
+    double buildMs = timeMs([&] { for (auto& [t, w] : dict) trie.insert(t, w); });
+    std::cout << "\n" << trie.size() << " terms, " << trie.nodeCount() << " nodes, " << trie.memoryBytes() / 1e6
+              << " MB, built in " << buildMs << " ms\n";
+
+    // Prefixes of 1-6 bytes taken from random terms.
+    std::vector<std::string> queries;
+    std::uint64_t s = 5;
+    for (std::size_t i = 0; i < numQueries; ++i) {
+        s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+        const std::string& t = dict[(s >> 33) % dict.size()].first;
+        queries.push_back(t.substr(0, 1 + (s >> 20) % 6));
+    }
+
+    // Per-query latency, best-first vs. exhaustive (results must agree on weights).
+    std::vector<double> fast, slow;
+    std::size_t touched = 0, mismatches = 0;
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        std::vector<AutocompleteTrie::Completion> a, b;
+        auto t0 = std::chrono::steady_clock::now();
+        a = trie.complete(queries[i], k, &touched);
+        auto t1 = std::chrono::steady_clock::now();
+        fast.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        if (i % 20 == 0) {
+            t0 = std::chrono::steady_clock::now();
+            b = trie.completeExhaustive(queries[i], k);
+            t1 = std::chrono::steady_clock::now();
+            slow.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+            bool same = a.size() == b.size();
+            for (std::size_t j = 0; same && j < a.size(); ++j) same = a[j].weight == b[j].weight;
+            mismatches += !same;
+        }
+    }
+    std::cout << "k=" << k << ", " << queries.size() << " queries (exhaustive on every 20th)\n"
+              << std::fixed << std::setprecision(2)
+              << "                 p50 us   p99 us   p99.9 us\n"
+              << "best-first     " << std::setw(8) << percentile(fast, 0.5) << std::setw(9) << percentile(fast, 0.99)
+              << std::setw(10) << percentile(fast, 0.999) << "   (" << static_cast<double>(touched) / queries.size() << " pops/query)\n"
+              << "exhaustive     " << std::setw(8) << percentile(slow, 0.5) << std::setw(9) << percentile(slow, 0.99)
+              << std::setw(10) << percentile(slow, 0.999) << "\n"
+              << "result mismatches: " << mismatches << "\n\ncomplete_many throughput\n";
+    for (unsigned t = 1; t <= maxThreads; t *= 2) {
+        std::size_t results = 0;
+        double ms = timeMs([&] { for (auto& r : trie.complete_many(queries, k, t)) results += r.size(); });
+        std::cout << "  " << t << " threads: " << queries.size() / ms / 1e3 << " M queries/s (" << results << " results)\n";
+    }
+    return mismatches == 0 ? 0 : 1;
+}
+
+/* Compilation: g++ -std=c++17 -pthread -Wall -Wextra -O2 Autocomplete.cpp -o Autocomplete */
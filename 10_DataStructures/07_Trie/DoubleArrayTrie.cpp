@@ -0,0 +1,441 @@
+/**
+ * @file DoubleArrayTrie.cpp
+ * @brief Read-only double-array trie built from sorted keys, saved to a file
+ *        and queried in place through mmap.
+ * @date 2026-10-17
+ *
+ * A static dictionary stored as the pointer-based Trie must be rebuilt node by
+ * node on every start. The double array (Aoe, 1989) encodes the same automaton
+ * in one flat array of {base, check} units:
+ *
+ *   child of state s on code c   t = base[s] + c,  valid iff check[t] == s
+ *
+ * Codes are byte + 1, and code 0 marks "a key ends here"; the unit reached by
+ * code 0 is a leaf whose base holds -(value + 1). Each transition is one array
+ * read plus one compare, and the array needs no pointers, so the saved file is
+ * the data structure: DoubleArrayTrie::open() maps it read-only and queries
+ * run directly on the mapping.
+ *
+ * The builder walks the sorted keys depth-first and places each state's
+ * children at the first base where all their slots are free (darts-style
+ * scan that skips regions which are almost full).
+ *
+ * POSIX only (open/mmap/munmap).
+ */
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <array>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class DoubleArrayTrie {
+public:
+    struct Unit {
+        std::int32_t base;
+        std::int32_t check;   // parent state, FREE when unused
+    };
+    struct Match {
+        std::size_t length;   // bytes of the query consumed by the key
+        std::uint32_t value;
+    };
+    enum class Verify { Header, Full };
+
+private:
+    static constexpr std::int32_t FREE = -1;
+    static constexpr unsigned CODES = 257;   // end marker + 256 byte values
+    static constexpr char MAGIC[8] = {'D', 'A', 'T', 'R', 'I', 'E', '\0', '\0'};
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t ENDIAN_MARKER = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianMarker;
+        std::uint64_t numUnits;
+        std::uint64_t numKeys;
+        std::uint64_t checksum;   // over the unit array
+        std::uint64_t reserved[3];
+    };
+    static_assert(sizeof(Header) == 64, "units must start cache-line aligned");
+
+    std::vector<Unit> storage;            // owned units after build()
+    const Unit* units = nullptr;          // storage.data() or into the mapping
+    std::size_t numUnits = 0;
+    std::size_t numKeys = 0;
+    void* mapped = MAP_FAILED;
+    std::size_t mappedLength = 0;
+
+    void unmap() {
+        if (mapped != MAP_FAILED) munmap(mapped, mappedLength);
+        mapped = MAP_FAILED;
+    }
+
+    static std::uint64_t checksum(const void* data, std::size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+        std::size_t i = 0;
+        for (; i + 8 <= bytes; i += 8) {
+            std::uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            h = (h ^ w) * 0xff51afd7ed558ccdULL;
+            h = (h << 31) | (h >> 33);
+        }
+        for (; i < bytes; ++i) h = (h ^ p[i]) * 0x100000001b3ULL;
+        return h ^ (h >> 29);
+    }
+
+    // Returns the child state of s on code c, or -1.
+    std::int64_t child(std::int64_t s, unsigned c) const {
+        std::int64_t t = static_cast<std::int64_t>(units[s].base) + c;
+        return t >= 0 && t < static_cast<std::int64_t>(numUnits) && units[t].check == s ? t : -1;
+    }
+
+    template<class F>
+    bool walk(std::int64_t s, std::string& key, F& fn) const {
+        for (unsigned c = 0; c < CODES; ++c) {
+            std::int64_t t = child(s, c);
+            if (t < 0) continue;
+            if (c == 0) {
+                if (!fn(std::string_view(key), static_cast<std::uint32_t>(-units[t].base - 1))) return false;
+                continue;
+            }
+            key.push_back(static_cast<char>(c - 1));
+            bool more = walk(t, key, fn);
+            key.pop_back();
+            if (!more) return false;
+        }
+        return true;
+    }
+
+    // Incremental placement of states into the unit array.
+    class Builder {
+        const std::vector<std::string>& keys;
+        const std::vector<std::uint32_t>* values;
+        std::vector<Unit>& out;
+        std::size_t nextCheckPos = 1;
+
+        void ensure(std::size_t size) { if (out.size() < size) out.resize(std::max(size, out.size() * 2), Unit{0, FREE}); }
+
+        std::int32_t findBase(const std::vector<unsigned>& codes) {
+            std::size_t pos = std::max<std::size_t>(codes[0] + 1, nextCheckPos) - 1;
+            std::size_t occupied = 0;
+            bool firstFree = true;
+            for (;;) {
+                ++pos;
+                ensure(pos + 1);
+                if (out[pos].check != FREE) { ++occupied; continue; }
+                if (firstFree) { nextCheckPos = pos; firstFree = false; }
+                std::size_t base = pos - codes[0];
+                if (base == 0) continue;
+                ensure(base + codes.back() + 1);
+                bool fits = true;
+                for (std::size_t i = 1; i < codes.size() && fits; ++i) fits = out[base + codes[i]].check == FREE;
+                if (!fits) continue;
+                // Stop rescanning a region once it is nearly full.
+                if (static_cast<double>(occupied) / static_cast<double>(pos - nextCheckPos + 1) >= 0.95) nextCheckPos = pos;
+                if (base > static_cast<std::size_t>(INT32_MAX - CODES)) throw std::length_error("DoubleArrayTrie: too many states");
+                return static_cast<std::int32_t>(base);
+            }
+        }
+
+    public:
+        Builder(const std::vector<std::string>& k, const std::vector<std::uint32_t>* v, std::vector<Unit>& u) : keys(k), values(v), out(u) {}
+
+        void run() {
+            out.assign(1024, Unit{0, FREE});
+            out[0].check = 0;   // root occupies unit 0
+            struct Task { std::int32_t state; std::size_t lo, hi, depth; };
+            std::vector<Task> stack{{0, 0, keys.size(), 0}};
+            std::vector<unsigned> codes;
+            std::vector<std::size_t> starts;
+            while (!stack.empty()) {
+                Task task = stack.back();
+                stack.pop_back();
+                // Distinct next codes of keys[lo, hi) at this depth (sorted input => sorted codes).
+                codes.clear();
+                starts.clear();
+                for (std::size_t i = task.lo; i < task.hi; ++i) {
+                    unsigned c = keys[i].size() == task.depth ? 0 : static_cast<unsigned char>(keys[i][task.depth]) + 1u;
+                    if (codes.empty() || codes.back() != c) { codes.push_back(c); starts.push_back(i); }
+                }
+                starts.push_back(task.hi);
+                std::int32_t base = findBase(codes);
+                out[static_cast<std::size_t>(task.state)].base = base;
+                for (unsigned c : codes) out[static_cast<std::size_t>(base) + c].check = task.state;
+                for (std::size_t i = codes.size(); i-- > 0;) {
+                    std::int32_t t = base + static_cast<std::int32_t>(codes[i]);
+                    if (codes[i] == 0) {
+                        std::uint32_t value = values ? (*values)[starts[i]] : static_cast<std::uint32_t>(starts[i]);
+                        out[static_cast<std::size_t>(t)].base = -static_cast<std::int32_t>(value) - 1;
+                    } else {
+                        stack.push_back({t, starts[i], starts[i + 1], task.depth + 1});
+                    }
+                }
+            }
+            std::size_t used = out.size();
+            while (used > 1 && out[used - 1].check == FREE) --used;
+            out.resize(used + CODES);   // slack so base + code of the last states stays in range
+        }
+    };
+
+public:
+    DoubleArrayTrie() = default;
+    DoubleArrayTrie(const DoubleArrayTrie&) = delete;
+    DoubleArrayTrie& operator=(const DoubleArrayTrie&) = delete;
+    DoubleArrayTrie(DoubleArrayTrie&& o) noexcept { *this = std::move(o); }
+    DoubleArrayTrie& operator=(DoubleArrayTrie&& o) noexcept {
+        if (this != &o) {
+            unmap();
+            storage = std::move(o.storage);
+            units = o.mapped != MAP_FAILED ? o.units : storage.data();
+            numUnits = o.numUnits; numKeys = o.numKeys;
+            std::swap(mapped, o.mapped); std::swap(mappedLength, o.mappedLength);
+            o.units = nullptr; o.numUnits = o.numKeys = 0;
+        }
+        return *this;
+    }
+    ~DoubleArrayTrie() { unmap(); }
+
+    // keys must be sorted and unique; values default to each key's index.
+    static DoubleArrayTrie build(const std::vector<std::string>& keys, const std::vector<std::uint32_t>* values = nullptr) {
+        for (std::size_t i = 1; i < keys.size(); ++i)
+            if (!(keys[i - 1] < keys[i])) throw std::invalid_argument("DoubleArrayTrie::build: keys must be sorted and unique");
+        if (values && values->size() != keys.size()) throw std::invalid_argument("DoubleArrayTrie::build: one value per key required");
+        if (keys.size() > INT32_MAX) throw std::length_error("DoubleArrayTrie::build: too many keys");
+        if (values && std::any_of(values->begin(), values->end(), [](std::uint32_t v) { return v >= INT32_MAX; }))
+            throw std::invalid_argument("DoubleArrayTrie::build: values must be below INT32_MAX");
+        DoubleArrayTrie t;
+        if (!keys.empty()) Builder(keys, values, t.storage).run();
+        else t.storage.assign(CODES + 1, Unit{0, FREE});
+        t.storage[0].check = 0;
+        if (keys.empty()) t.storage[0].base = 1;   // base 0 would make the root its own end-marker child
+        t.units = t.storage.data();
+        t.numUnits = t.storage.size();
+        t.numKeys = keys.size();
+        return t;
+    }
+
+    void save(const std::string& path) const {
+        Header h{};
+        std::memcpy(h.magic, MAGIC, sizeof MAGIC);
+        h.version = VERSION;
+        h.endianMarker = ENDIAN_MARKER;
+        h.numUnits = numUnits;
+        h.numKeys = numKeys;
+        h.checksum = checksum(units, numUnits * sizeof(Unit));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("DoubleArrayTrie::save: cannot create " + path);
+        out.write(reinterpret_cast<const char*>(&h), sizeof h);
+        out.write(reinterpret_cast<const char*>(units), static_cast<std::streamsize>(numUnits * sizeof(Unit)));
+        if (!out) throw std::runtime_error("DoubleArrayTrie::save: I/O error on " + path);
+    }
+
+    // Maps a saved trie; no unit is read until a query touches it (unless
+    // Verify::Full checksums the whole array).
+    static DoubleArrayTrie open(const std::string& path, Verify verify = Verify::Header) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("DoubleArrayTrie::open: cannot open " + path);
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+            ::close(fd);
+            throw std::runtime_error("DoubleArrayTrie::open: " + path + " is too small");
+        }
+        DoubleArrayTrie t;
+        t.mappedLength = static_cast<std::size_t>(st.st_size);
+        t.mapped = mmap(nullptr, t.mappedLength, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (t.mapped == MAP_FAILED) throw std::runtime_error("DoubleArrayTrie::open: mmap failed for " + path);
+
+        const Header* h = static_cast<const Header*>(t.mapped);
+        if (std::memcmp(h->magic, MAGIC, sizeof MAGIC) != 0) throw std::runtime_error("DoubleArrayTrie::open: not a double-array trie file");
+        if (h->endianMarker != ENDIAN_MARKER) throw std::runtime_error("DoubleArrayTrie::open: byte order mismatch");
+        if (h->version != VERSION) throw std::runtime_error("DoubleArrayTrie::open: unsupported version " + std::to_string(h->version));
+        if (h->numUnits == 0 || h->numUnits > (t.mappedLength - sizeof(Header)) / sizeof(Unit))
+            throw std::runtime_error("DoubleArrayTrie::open: truncated file");
+        t.units = reinterpret_cast<const Unit*>(static_cast<const char*>(t.mapped) + sizeof(Header));
+        t.numUnits = h->numUnits;
+        t.numKeys = h->numKeys;
+        if (verify == Verify::Full && checksum(t.units, t.numUnits * sizeof(Unit)) != h->checksum)
+            throw std::runtime_error("DoubleArrayTrie::open: checksum mismatch");
+        return t;   // t's destructor unmaps if any check above threw
+    }
+
+    std::size_t size() const { return numKeys; }
+    std::size_t memoryBytes() const { return numUnits * sizeof(Unit); }
+    bool isMapped() const { return mapped != MAP_FAILED; }
+
+    // Value stored for key, or -1.
+    std::int64_t find(std::string_view key) const {
+        std::int64_t s = 0;
+        for (char ch : key)
+            if ((s = child(s, static_cast<unsigned char>(ch) + 1u)) < 0) return -1;
+        std::int64_t t = child(s, 0);
+        return t < 0 ? -1 : -static_cast<std::int64_t>(units[t].base) - 1;
+    }
+    bool contains(std::string_view key) const { return find(key) >= 0; }
+
+    // Finds the longest key that is a prefix of text; returns false if none
+    // (an empty key, when present, matches with length 0).
+    bool longest_prefix_match(std::string_view text, Match& match) const {
+        bool found = false;
+        std::int64_t s = 0;
+        for (std::size_t i = 0;; ++i) {
+            std::int64_t t = child(s, 0);
+            if (t >= 0) { match = {i, static_cast<std::uint32_t>(-units[t].base - 1)}; found = true; }
+            if (i == text.size() || (s = child(s, static_cast<unsigned char>(text[i]) + 1u)) < 0) return found;
+        }
+    }
+
+    // Calls fn(std::string_view key, std::uint32_t value) for every key
+    // starting with prefix, in lexicographic order; fn returns false to stop.
+    template<class F>
+    void prefix_iterate(std::string_view prefix, F fn) const {
+        std::int64_t s = 0;
+        for (char ch : prefix)
+            if ((s = child(s, static_cast<unsigned char>(ch) + 1u)) < 0) return;
+        std::string key(prefix);
+        walk(s, key, fn);
+    }
+};
+
+// The original pointer trie (TrieImplementation.cpp), as the baseline.
+struct TrieNode {
+    std::array<std::unique_ptr<TrieNode>, 26> children{};
+    bool terminal = false;
+};
+
+class Trie {
+    std::unique_ptr<TrieNode> root = std::make_unique<TrieNode>();
+    std::size_t nodes = 1;
+public:
+    void insert(const std::string& word) {
+        TrieNode* node = root.get();
+        for (char ch : word) {
+            if (ch < 'a' || ch > 'z') continue;
+            std::size_t idx = static_cast<std::size_t>(ch - 'a');
+            if (!node->children[idx]) { node->children[idx] = std::make_unique<TrieNode>(); ++nodes; }
+            node = node->children[idx].get();
+        }
+        node->terminal = true;
+    }
+    bool contains(const std::string& word) const {
+        const TrieNode* node = root.get();
+        for (char ch : word) {
+            if (ch < 'a' || ch > 'z') return false;
+            std::size_t idx = static_cast<std::size_t>(ch - 'a');
+            if (!node->children[idx]) return false;
+            node = node->children[idx].get();
+        }
+        return node->terminal;
+    }
+    std::size_t memoryBytes() const { return nodes * (sizeof(TrieNode) + 16); }   // + malloc header
+};
+
+// Pronounceable lowercase words built from syllables, so prefixes are shared.
+std::vector<std::string> makeWords(std::size_t n, std::uint64_t seed) {
+    static const char* const syllables[] = {"an", "ber", "ca", "de", "el", "fo", "gra", "hu", "in", "jo", "ka", "lu", "mi",
+                                            "no", "or", "pa", "qui", "re", "sa", "ti", "un", "ve", "wo", "xi", "yo", "ze"};
+    auto next = [&seed] { seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; return seed; };
+    std::vector<std::string> words;
+    words.reserve(n);
+    while (words.size() < n) {
+        std::string w;
+        for (std::uint64_t k = 1 + next() % 5; k > 0; --k) w += syllables[next() % 26];
+        if (next() % 3 == 0) w += "s";
+        words.push_back(std::move(w));
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
+template<class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Double-array trie ===\n";
+    const std::string smallPath = "small_dict.dat";
+    {
+        std::vector<std::string> keys{"he", "hell", "hello", "help", "world"};
+        DoubleArrayTrie::build(keys).save(smallPath);
+        DoubleArrayTrie t = DoubleArrayTrie::open(smallPath, DoubleArrayTrie::Verify::Full);
+        std::cout << "mapped=" << t.isMapped() << " keys=" << t.size() << " units=" << t.memoryBytes() / sizeof(DoubleArrayTrie::Unit)
+                  << "\ncontains(\"hell\")=" << t.contains("hell") << " contains(\"hel\")=" << t.contains("hel")
+                  << " find(\"world\")=" << t.find("world") << "\n";
+        DoubleArrayTrie::Match m{};
+        if (t.longest_prefix_match("helloween", m)) std::cout << "longest_prefix_match(\"helloween\") = \"helloween\"[0.." << m.length << ") value " << m.value << "\n";
+        std::cout << "prefix_iterate(\"hel\"):";
+        t.prefix_iterate("hel", [](std::string_view k, std::uint32_t v) { std::cout << ' ' << k << '=' << v; return true; });
+        std::cout << "\n";
+    }
+    std::remove(smallPath.c_str());
+
+    // Usage: ./DoubleArrayTrie [words] [path]
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 300000;
+    std::string path = argc > 2 ? argv[2] : "bench_dict.dat";
+    std::vector<std::string> words = makeWords(n, 0x2545f4914f6cdd1dULL);
+
+    Trie pointerTrie;
+    double trieBuild = timeMs([&] { for (auto& w : words) pointerTrie.insert(w); });
+    DoubleArrayTrie built;
+    double datBuild = timeMs([&] { built = DoubleArrayTrie::build(words); });
+    double saveMs = timeMs([&] { built.save(path); });
+    DoubleArrayTrie mapped;
+    double openMs = timeMs([&] { mapped = DoubleArrayTrie::open(path); });
+
+    // Half hits, half misses (a trailing letter changed), shuffled.
+    std::vector<std::string> probes;
+    std::uint64_t s = 99;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+        std::string w = words[(s >> 33) % words.size()];
+        if (i & 1) w.back() = static_cast<char>('a' + (w.back() - 'a' + 1) % 26);
+        probes.push_back(std::move(w));
+    }
+    std::size_t trieHits = 0, datHits = 0;
+    double trieLookup = timeMs([&] { for (auto& p : probes) trieHits += pointerTrie.contains(p); });
+    double datLookup = timeMs([&] { for (auto& p : probes) datHits += mapped.contains(p); });
+    std::size_t matched = 0;
+    double lpm = timeMs([&] {
+        DoubleArrayTrie::Match m{};
+        for (auto& p : probes) if (mapped.longest_prefix_match(p + "xyz", m)) matched += m.length;
+    });
+    std::size_t listed = 0;
+    double iterate = timeMs([&] { mapped.prefix_iterate("", [&](std::string_view, std::uint32_t) { ++listed; return true; }); });
+
+    bool ok = trieHits == datHits && listed == words.size();
+    for (std::size_t i = 0; i < words.size(); i += 97) ok &= mapped.find(words[i]) == static_cast<std::int64_t>(i);
+
+    std::cout << "\n" << words.size() << " words\n"
+              << "                     pointer Trie   double array\n"
+              << "memory (MB)          " << pointerTrie.memoryBytes() / 1e6 << "\t    " << mapped.memoryBytes() / 1e6
+              << "   (" << static_cast<double>(pointerTrie.memoryBytes()) / static_cast<double>(mapped.memoryBytes()) << "x smaller)\n"
+              << "build (ms)           " << trieBuild << "\t    " << datBuild << "   (+ save " << saveMs << " ms)\n"
+              << "startup (ms)         rebuild         mmap open " << openMs << "\n"
+              << "contains (ns/query)  " << trieLookup * 1e6 / probes.size() << "\t    " << datLookup * 1e6 / probes.size() << "\n"
+              << "longest_prefix_match " << lpm * 1e6 / probes.size() << " ns/query, prefix_iterate(all) " << iterate << " ms\n"
+              << "check: " << (ok ? "ok" : "FAILED") << " (hits " << datHits << ", matched bytes " << matched << ")\n";
+    std::remove(path.c_str());
+    return ok ? 0 : 1;
+}
+
+/* Compilation: g++ -std=c++17 -Wall -Wextra -O2 DoubleArrayTrie.cpp -o DoubleArrayTrie */